@@ -196,8 +196,7 @@ static bool activate_whistle(player_type *user_ptr, ae_type *ae_ptr)
         if (is_pet(&user_ptr->current_floor_ptr->m_list[pet_ctr]) && (user_ptr->riding != pet_ctr))
             who[max_pet++] = pet_ctr;
 
-    uint16_t dummy_why;
-    ang_sort(user_ptr, who, &dummy_why, max_pet, ang_sort_comp_pet, ang_sort_swap_hook);
+    ang_sort(who, max_pet, [user_ptr](MONSTER_IDX w1, MONSTER_IDX w2) { return ang_sort_comp_pet(user_ptr, w1, w2); });
     for (MONSTER_IDX i = 0; i < max_pet; i++) {
         pet_ctr = who[i];
         teleport_monster_to(user_ptr, pet_ctr, user_ptr->y, user_ptr->x, 100, TELEPORT_PASSIVE);
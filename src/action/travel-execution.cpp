@@ -6,6 +6,7 @@
 #include "action/travel-execution.h"
 #include "action/movement-execution.h"
 #include "action/run-execution.h"
+#include "cmd-action/cmd-travel.h"
 #include "core/disturbance.h"
 #include "floor/geometry.h"
 #include "game-option/disturbance-options.h"
@@ -126,4 +127,5 @@ void forget_travel_flow(floor_type *floor_ptr)
             travel.cost[y][x] = MAX_SHORT;
 
     travel.y = travel.x = 0;
+    forget_travel_flow_cache();
 }
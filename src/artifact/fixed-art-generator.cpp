@@ -29,6 +29,9 @@
 #include "system/object-type-definition.h"
 #include "system/player-type-definition.h"
 #include "util/bit-flags-calculator.h"
+#include <map>
+#include <utility>
+#include <vector>
 
 /*!
  * @brief 恐怖の仮面への特殊処理
@@ -254,6 +257,55 @@ bool create_named_art(player_type *player_ptr, ARTIFACT_IDX a_idx, POSITION y, P
     return drop_near(player_ptr, q_ptr, -1, y, x) ? true : false;
 }
 
+/*!
+ * @brief ベースアイテムに対応する非INSTA_ART型固定アーティファクトの一覧を返す
+ * @param tval ベースアイテムの大項目
+ * @param sval ベースアイテムの小項目
+ * @return 固定アーティファクトIDの昇順の一覧
+ * @details
+ * a_info の生成条件のうちゲーム中に変わらないもの (名前・INSTA_ART・tval/sval) だけを、初めて使う時に一度だけ索引にまとめる。
+ * QUESTITEMはクエストの受領や失敗で付け外しされるため、生成数と同様に呼び出し元で毎回調べること。
+ */
+static const std::vector<ARTIFACT_IDX> &get_artifact_candidates(tval_type tval, OBJECT_SUBTYPE_VALUE sval)
+{
+    static std::map<std::pair<tval_type, OBJECT_SUBTYPE_VALUE>, std::vector<ARTIFACT_IDX>> candidates;
+    static const std::vector<ARTIFACT_IDX> none;
+    static bool is_indexed = false;
+    if (!is_indexed) {
+        for (ARTIFACT_IDX i = 0; i < max_a_idx; i++) {
+            auto a_ptr = &a_info[i];
+            if (!a_ptr->name.empty() && a_ptr->gen_flags.has_not(TRG::INSTA_ART))
+                candidates[{ a_ptr->tval, a_ptr->sval }].push_back(i);
+        }
+
+        is_indexed = true;
+    }
+
+    auto it = candidates.find({ tval, sval });
+    return it == candidates.end() ? none : it->second;
+}
+
+/*!
+ * @brief INSTA_ART型固定アーティファクトの一覧を返す
+ * @return 固定アーティファクトIDの昇順の一覧
+ */
+static const std::vector<ARTIFACT_IDX> &get_special_artifact_candidates(void)
+{
+    static std::vector<ARTIFACT_IDX> candidates;
+    static bool is_indexed = false;
+    if (!is_indexed) {
+        for (ARTIFACT_IDX i = 0; i < max_a_idx; i++) {
+            auto a_ptr = &a_info[i];
+            if (!a_ptr->name.empty() && a_ptr->gen_flags.has(TRG::INSTA_ART))
+                candidates.push_back(i);
+        }
+
+        is_indexed = true;
+    }
+
+    return candidates;
+}
+
 /*!
  * @brief 非INSTA_ART型の固定アーティファクトの生成を確率に応じて試行する。
  * Mega-Hack -- Attempt to create one of the "Special Objects"
@@ -274,25 +326,9 @@ bool make_artifact(player_type *player_ptr, object_type *o_ptr)
     if (o_ptr->number != 1)
         return false;
 
-    for (ARTIFACT_IDX i = 0; i < max_a_idx; i++) {
+    for (ARTIFACT_IDX i : get_artifact_candidates(o_ptr->tval, o_ptr->sval)) {
         auto a_ptr = &a_info[i];
-
-        if (a_ptr->name.empty())
-            continue;
-
-        if (a_ptr->cur_num)
-            continue;
-
-        if (a_ptr->gen_flags.has(TRG::QUESTITEM))
-            continue;
-
-        if (a_ptr->gen_flags.has(TRG::INSTA_ART))
-            continue;
-
-        if (a_ptr->tval != o_ptr->tval)
-            continue;
-
-        if (a_ptr->sval != o_ptr->sval)
+        if (a_ptr->gen_flags.has(TRG::QUESTITEM) || a_ptr->cur_num)
             continue;
 
         if (a_ptr->level > floor_ptr->dun_level) {
@@ -336,20 +372,12 @@ bool make_artifact_special(player_type *player_ptr, object_type *o_ptr)
     if (get_obj_num_hook)
         return false;
 
-    /*! @note 全固定アーティファクト中からIDの若い順に生成対象とその確率を走査する / Check the artifact list (just the "specials") */
-    for (ARTIFACT_IDX i = 0; i < max_a_idx; i++) {
+    /*! @note INSTA_ART型固定アーティファクト中からIDの若い順に生成対象とその確率を走査する / Check the artifact list (just the "specials") */
+    for (ARTIFACT_IDX i : get_special_artifact_candidates()) {
         auto a_ptr = &a_info[i];
 
-        /*! @note アーティファクト名が空の不正なデータは除外する / Skip "empty" artifacts */
-        if (a_ptr->name.empty())
-            continue;
-
-        /*! @note 既に生成回数がカウントされたアーティファクト、QUESTITEMと非INSTA_ARTは除外 / Cannot make an artifact twice */
-        if (a_ptr->cur_num)
-            continue;
-        if (a_ptr->gen_flags.has(TRG::QUESTITEM))
-            continue;
-        if (!(a_ptr->gen_flags.has(TRG::INSTA_ART)))
+        /*! @note クエスト対象のアーティファクトと、既に生成回数がカウントされたアーティファクトは除外 / Cannot make a quest item or an artifact twice */
+        if (a_ptr->gen_flags.has(TRG::QUESTITEM) || a_ptr->cur_num)
             continue;
 
         /*! @note アーティファクト生成階が現在に対して足りない場合は高確率で1/(不足階層*2)を満たさないと生成リストに加えられない /
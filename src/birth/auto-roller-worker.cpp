@@ -0,0 +1,195 @@
+﻿/*!
+ * @brief オートローラーの能力値ロールを複数スレッドで行う / Roll stats for the autoroller on worker threads
+ * @date 2026/10/19
+ * @details
+ * 1回の呼び出しで AUTOROLLER_CHUNK_NUM 個の区画 (各 AUTOROLLER_CHUNK_SIZE 回分のロール) を処理する。
+ * 各区画の乱数状態は呼び出し時にメインの乱数から区画番号順に派生させるため、
+ * どのスレッドがどの区画を受け持っても結果は変わらない。
+ * 条件を満たした能力値が複数の区画で見つかった場合は、区画番号が最も小さいものを採用する。
+ * したがって乱数の種を固定していれば、スレッド数に関わらず同じキャラクターが得られる。
+ */
+
+#include "birth/auto-roller-worker.h"
+#include "birth/auto-roller.h"
+#include "birth/birth-stat.h"
+#include "player-ability/player-ability-types.h"
+#include "system/player-type-definition.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr int AUTOROLLER_CHUNK_NUM = 64; //!< 1回の呼び出しで処理する区画数
+constexpr int AUTOROLLER_CHUNK_SIZE = 2048; //!< 1区画あたりのロール回数
+constexpr int AUTOROLLER_MAX_WORKERS = 15; //!< 作業スレッド数の上限 (呼び出し元のスレッドを除く)
+
+/*!
+ * @brief 1区画分のロールとその結果
+ */
+struct stat_chunk_type {
+    uint32_t rng_state[4]; //!< この区画専用の乱数状態
+    int found_at; //!< 条件を満たしたロールの区画内での位置 (見つからなければ-1)
+    BASE_STATUS stats[A_MAX]; //!< 条件を満たした能力値、または区画の最後にロールした能力値
+};
+
+/*!
+ * @brief 区画内のロールを行う
+ * @param chunk 処理する区画
+ */
+void roll_chunk(stat_chunk_type &chunk)
+{
+    chunk.found_at = -1;
+    for (int n = 0; n < AUTOROLLER_CHUNK_SIZE; n++) {
+        roll_base_stats(chunk.rng_state, chunk.stats);
+        bool accept = true;
+        for (int i = 0; i < A_MAX; i++) {
+            if (chunk.stats[i] < stat_limit[i]) {
+                accept = false;
+                break;
+            }
+        }
+
+        if (accept) {
+            chunk.found_at = n;
+            return;
+        }
+    }
+}
+
+/*!
+ * @brief 作業スレッドとその区画
+ * @details
+ * 呼び出し元のスレッドも区画の処理に加わるため、作業スレッドが無くても動作する。
+ * 区画は番号順に取り出され、条件を満たす能力値が見つかった区画より後ろの区画は処理しない。
+ */
+class auto_roller_worker_type {
+public:
+    ~auto_roller_worker_type()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stop_requested = true;
+        }
+
+        this->start_cv.notify_all();
+        for (auto &worker : this->workers)
+            worker.join();
+    }
+
+    int roll(std::vector<stat_chunk_type> &chunks)
+    {
+        this->start_workers();
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->chunks = &chunks;
+            this->next_chunk = 0;
+            this->first_found = static_cast<int>(chunks.size());
+            this->running = static_cast<int>(this->workers.size());
+            this->generation++;
+        }
+
+        this->start_cv.notify_all();
+        this->process_chunks();
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done_cv.wait(lock, [this] { return this->running == 0; });
+        this->chunks = nullptr;
+        return this->first_found;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    std::vector<stat_chunk_type> *chunks = nullptr;
+    std::atomic<int> next_chunk{ 0 };
+    std::atomic<int> first_found{ 0 };
+    int running = 0;
+    uint32_t generation = 0;
+    bool stop_requested = false;
+
+    void start_workers()
+    {
+        if (!this->workers.empty())
+            return;
+
+        int num = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+        num = std::clamp(num, 0, AUTOROLLER_MAX_WORKERS);
+        for (int i = 0; i < num; i++)
+            this->workers.emplace_back(&auto_roller_worker_type::run, this);
+    }
+
+    void process_chunks()
+    {
+        while (true) {
+            int idx = this->next_chunk.fetch_add(1);
+            if (idx >= this->first_found.load())
+                return;
+
+            auto &chunk = (*this->chunks)[idx];
+            roll_chunk(chunk);
+            if (chunk.found_at < 0)
+                continue;
+
+            int found = this->first_found.load();
+            while ((idx < found) && !this->first_found.compare_exchange_weak(found, idx))
+                ;
+        }
+    }
+
+    void run()
+    {
+        uint32_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->start_cv.wait(lock, [this, seen] { return this->stop_requested || (this->generation != seen); });
+                if (this->stop_requested)
+                    return;
+
+                seen = this->generation;
+            }
+
+            this->process_chunks();
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->running--;
+            }
+
+            this->done_cv.notify_one();
+        }
+    }
+};
+
+auto_roller_worker_type auto_roller_worker;
+}
+
+/*!
+ * @brief 能力値の下限を満たすまで、まとまった回数のロールを並列に行う /
+ * Roll a batch of stat sets in parallel, stopping at the first one that meets the limits
+ * @param creature_ptr プレーヤーへの参照ポインタ
+ * @param rolls 消費したロール回数を返す参照ポインタ (見つかった場合はそのロールまでを数える)
+ * @return 下限を満たす能力値が見つかったらTRUE
+ * @details
+ * 見つかった場合はその能力値を、見つからなかった場合は最後の区画で最後にロールした能力値をプレイヤーに設定する。
+ * メインの乱数は見つかったかどうかに関わらず、区画数に応じた一定量だけ進む。
+ */
+bool roll_stats_in_parallel(player_type *creature_ptr, int32_t *rolls)
+{
+    static std::vector<stat_chunk_type> chunks(AUTOROLLER_CHUNK_NUM);
+    for (auto &chunk : chunks)
+        Rand_state_split(chunk.rng_state);
+
+    int found = auto_roller_worker.roll(chunks);
+    bool is_found = found < AUTOROLLER_CHUNK_NUM;
+    const auto &result = is_found ? chunks[found] : chunks.back();
+    *rolls = is_found ? (found * AUTOROLLER_CHUNK_SIZE + result.found_at + 1) : (AUTOROLLER_CHUNK_NUM * AUTOROLLER_CHUNK_SIZE);
+    for (int i = 0; i < A_MAX; i++)
+        creature_ptr->stat_cur[i] = creature_ptr->stat_max[i] = result.stats[i];
+
+    return is_found;
+}
@@ -0,0 +1,6 @@
+﻿#pragma once
+
+#include "system/angband.h"
+
+typedef struct player_type player_type;
+bool roll_stats_in_parallel(player_type *creature_ptr, int32_t *rolls);
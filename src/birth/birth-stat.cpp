@@ -53,18 +53,17 @@ int adjust_stat(int value, int amount)
 }
 
 /*!
- * @brief プレイヤーの能力値を一通りロールする。 / Roll for a characters stats
- * @param creature_ptr プレーヤーへの参照ポインタ
- * @details
- * calc_bonuses()による、独立ステータスからの副次ステータス算出も行っている。
- * For efficiency, we include a chunk of "calc_bonuses()".\n
+ * @brief 能力値の基本値を一通りロールする / Roll a set of base stats
+ * @param rng_state 使用する乱数の状態 (通常は Rand_state)
+ * @param stats ロール結果を格納する配列 (A_MAX 要素)
+ * @details オートローラーの作業スレッドからも、スレッドごとの乱数状態を渡して呼ばれる。
  */
-void get_stats(player_type* creature_ptr)
+void roll_base_stats(uint32_t *rng_state, BASE_STATUS *stats)
 {
     while (true) {
         int sum = 0;
         for (int i = 0; i < 2; i++) {
-            int32_t tmp = randint0(60 * 60 * 60);
+            int32_t tmp = Rand_div_state(rng_state, 60 * 60 * 60);
             BASE_STATUS val;
 
             for (int j = 0; j < 3; j++) {
@@ -74,7 +73,7 @@ void get_stats(player_type* creature_ptr)
                 val = rand3_4_5[tmp % 60];
 
                 sum += val;
-                creature_ptr->stat_cur[stat] = creature_ptr->stat_max[stat] = val;
+                stats[stat] = val;
 
                 tmp /= 60;
             }
@@ -85,6 +84,21 @@ void get_stats(player_type* creature_ptr)
     }
 }
 
+/*!
+ * @brief プレイヤーの能力値を一通りロールする。 / Roll for a characters stats
+ * @param creature_ptr プレーヤーへの参照ポインタ
+ * @details
+ * calc_bonuses()による、独立ステータスからの副次ステータス算出も行っている。
+ * For efficiency, we include a chunk of "calc_bonuses()".\n
+ */
+void get_stats(player_type* creature_ptr)
+{
+    BASE_STATUS stats[A_MAX];
+    roll_base_stats(Rand_state, stats);
+    for (int i = 0; i < A_MAX; i++)
+        creature_ptr->stat_cur[i] = creature_ptr->stat_max[i] = stats[i];
+}
+
 /*!
  * @brief 経験値修正の合計値を計算
  */
@@ -4,6 +4,7 @@
 
 typedef struct player_type player_type;
 int adjust_stat(int value, int amount);
+void roll_base_stats(uint32_t *rng_state, BASE_STATUS *stats);
 void get_stats(player_type* creature_ptr);
 uint16_t get_expfact(player_type *creature_ptr);
 void get_extra(player_type *creature_ptr, bool roll_hitdie);
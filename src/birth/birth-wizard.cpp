@@ -1,5 +1,6 @@
 ﻿#include "birth/birth-wizard.h"
 #include "avatar/avatar.h"
+#include "birth/auto-roller-worker.h"
 #include "birth/auto-roller.h"
 #include "birth/birth-body-spec.h"
 #include "birth/birth-explanations-table.h"
@@ -37,6 +38,7 @@
 #include "view/display-birth.h" // 暫定。後で消す予定。
 #include "view/display-player.h" // 暫定。後で消す.
 #include "world/world.h"
+#include <chrono>
 
 /*!
  * オートローラーの内容を描画する間隔 /
@@ -336,29 +338,13 @@ static void auto_roller_count(void)
     if (auto_round < 1000000000L)
         return;
 
-    auto_round = 1;
+    auto_round -= 1000000000L - 1;
     if (!autoroller)
         return;
 
     auto_upper_round++;
 }
 
-static bool decide_initial_stat(player_type *creature_ptr)
-{
-    if (!autoroller)
-        return true;
-
-    bool accept = true;
-    for (int i = 0; i < A_MAX; i++) {
-        if (creature_ptr->stat_max[i] < stat_limit[i]) {
-            accept = false;
-            break;
-        }
-    }
-
-    return accept;
-}
-
 static bool decide_body_spec(player_type *creature_ptr, chara_limit_type chara_limit, bool *accept)
 {
     if (!*accept)
@@ -381,16 +367,26 @@ static bool decide_body_spec(player_type *creature_ptr, chara_limit_type chara_l
     return *accept;
 }
 
-static bool display_auto_roller_count(player_type *creature_ptr, const int col)
+/*!
+ * @brief オートローラーの回数と速度を表示し、中断キーを確認する
+ * @param creature_ptr プレーヤーへの参照ポインタ
+ * @param col 表示する列
+ * @param total_rolls 今回のオートロール開始からのロール回数
+ * @param start_time 今回のオートロールを開始した時刻
+ * @return 中断キーが押されたらTRUE
+ */
+static bool display_auto_roller_count(player_type *creature_ptr, const int col, int64_t total_rolls, std::chrono::steady_clock::time_point start_time)
 {
-    if ((auto_round % AUTOROLLER_STEP) != 0)
-        return false;
-
     birth_put_stats(creature_ptr);
     if (auto_upper_round)
         put_str(format("%ld%09ld", auto_upper_round, auto_round), 10, col + 20);
     else
         put_str(format("%10ld", auto_round), 10, col + 20);
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    if (elapsed > 0)
+        put_str(format(_("%10.0f回/秒", "%10.0f/sec"), total_rolls / elapsed), 12, col + 20);
+
     term_fresh();
     inkey_scan = true;
     if (inkey()) {
@@ -402,17 +398,42 @@ static bool display_auto_roller_count(player_type *creature_ptr, const int col)
     return false;
 }
 
+/*!
+ * @brief オートローラーを回す
+ * @param creature_ptr プレーヤーへの参照ポインタ
+ * @param chara_limit 社会的地位の要求水準
+ * @param col 表示する列
+ * @details
+ * 能力値の下限を指定している場合は、能力値のロールを作業スレッドでまとめて行い、
+ * 下限を満たしたものについてだけ体格等の判定をこのスレッドで行う。
+ */
 static void exe_auto_roller(player_type *creature_ptr, chara_limit_type chara_limit, const int col)
 {
-    while (autoroller || autochara) {
+    auto start_time = std::chrono::steady_clock::now();
+    int64_t total_rolls = 0;
+    while (autoroller) {
+        int32_t rolls;
+        bool accept = roll_stats_in_parallel(creature_ptr, &rolls);
+        auto_round += rolls;
+        total_rolls += rolls;
+        auto_roller_count();
+        if (decide_body_spec(creature_ptr, chara_limit, &accept))
+            return;
+
+        if (display_auto_roller_count(creature_ptr, col, total_rolls, start_time))
+            return;
+    }
+
+    while (autochara) {
         get_stats(creature_ptr);
         auto_round++;
+        total_rolls++;
         auto_roller_count();
-        bool accept = decide_initial_stat(creature_ptr);
+        bool accept = true;
         if (decide_body_spec(creature_ptr, chara_limit, &accept))
             return;
 
-        if (display_auto_roller_count(creature_ptr, col))
+        if (((auto_round % AUTOROLLER_STEP) == 0) && display_auto_roller_count(creature_ptr, col, total_rolls, start_time))
             return;
     }
 }
@@ -486,6 +507,7 @@ static bool display_auto_roller(player_type *creature_ptr, chara_limit_type char
         if (autoroller || autochara) {
             term_clear();
             put_str(_("回数 :", "Round:"), 10, col + 10);
+            put_str(_("速度 :", "Speed:"), 12, col + 10);
             put_str(_("(ESCで停止)", "(Hit ESC to stop)"), 13, col + 13);
         } else {
             get_stats(creature_ptr);
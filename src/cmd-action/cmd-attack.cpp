@@ -164,6 +164,7 @@ static void natural_attack(player_type *attacker_ptr, MONSTER_IDX m_idx, MUTA at
  */
 bool do_cmd_attack(player_type *attacker_ptr, POSITION y, POSITION x, combat_options mode)
 {
+    RandomStreamScope rand_scope(RandomStream::COMBAT);
     grid_type *g_ptr = &attacker_ptr->current_floor_ptr->grid_array[y][x];
     monster_type *m_ptr = &attacker_ptr->current_floor_ptr->m_list[g_ptr->m_idx];
     monster_race *r_ptr = &r_info[m_ptr->r_idx];
@@ -77,7 +77,6 @@ void do_cmd_pet_dismiss(player_type *creature_ptr)
     int Dismissed = 0;
 
     MONSTER_IDX *who;
-    uint16_t dummy_why;
     int max_pet = 0;
     bool cu, cv;
 
@@ -95,7 +94,7 @@ void do_cmd_pet_dismiss(player_type *creature_ptr)
             who[max_pet++] = pet_ctr;
     }
 
-    ang_sort(creature_ptr, who, &dummy_why, max_pet, ang_sort_comp_pet_dismiss, ang_sort_swap_hook);
+    ang_sort(who, max_pet, [creature_ptr](MONSTER_IDX w1, MONSTER_IDX w2) { return ang_sort_comp_pet_dismiss(creature_ptr, w1, w2); });
 
     /* Process the monsters (backwards) */
     for (i = 0; i < max_pet; i++) {
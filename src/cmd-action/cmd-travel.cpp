@@ -13,6 +13,8 @@
 #include "target/grid-selector.h"
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
+#include <algorithm>
+#include <vector>
 
 #define TRAVEL_UNABLE 9999
 
@@ -60,49 +62,212 @@ static int travel_flow_cost(player_type *creature_ptr, POSITION y, POSITION x)
 }
 
 /*!
- * @brief トラベル処理の到達地点までの行程を得る処理のサブルーチン
+ * @brief 計算済みのコスト場を目標地点ごとに覚えておくための情報
+ * @details
+ * 各グリッドの地形・記憶状態を署名として保存しておき、次に同じ目標へトラベルする際に署名を比べる。
+ * 何も変わっていなければコスト場をそのまま使い、通りやすくなっただけのグリッドしかなければそこから差分だけを計算し直す。
+ */
+struct travel_flow_cache_type {
+    bool valid; //!< コスト場が計算済みか
+    POSITION y; //!< 目標地点のY座標
+    POSITION x; //!< 目標地点のX座標
+    POSITION height; //!< 計算した時のフロアの高さ
+    POSITION width; //!< 計算した時のフロアの幅
+    bool in_dungeon; //!< 計算した時にダンジョン内にいたか
+    bool levitation; //!< 計算した時に浮遊していたか
+    bool resist_fire; //!< 計算した時に火炎耐性があったか
+    bool wall; //!< 計算した時に壁の中にいたか
+    uint32_t signature[MAX_HGT][MAX_WID]; //!< 計算した時の各グリッドの地形と記憶状態
+    int weight[MAX_HGT][MAX_WID]; //!< 各グリッドへ進入するコスト
+};
+
+/*!
+ * @brief コスト場の計算待ちのグリッド
+ */
+struct travel_flow_entry_type {
+    int cost; //!< 積んだ時点でのコスト
+    POSITION y;
+    POSITION x;
+};
+
+static constexpr int TRAVEL_FLOW_BLOCKED = -1; //!< 進入できないグリッド
+static constexpr int TRAVEL_FLOW_WALL = -2; //!< 壁の中からだけ進入できるグリッド
+
+static travel_flow_cache_type travel_flow_cache;
+static std::vector<std::vector<travel_flow_entry_type>> travel_flow_buckets; //!< コスト毎の計算待ちグリッド (Dialのアルゴリズム)
+
+/*!
+ * @brief グリッドの地形と記憶状態をまとめた署名を返す
+ * @param g_ptr グリッドへの参照ポインタ
+ * @return 署名
+ */
+static uint32_t travel_flow_signature(grid_type *g_ptr)
+{
+    return static_cast<uint16_t>(g_ptr->feat) | ((g_ptr->mimic != 0) ? (1UL << 16) : 0) | ((g_ptr->info & CAVE_MARK) ? (1UL << 17) : 0)
+        | ((g_ptr->info & CAVE_KNOWN) ? (1UL << 18) : 0);
+}
+
+/*!
+ * @brief グリッドへ進入するコストを返す
  * @param creature_ptr	プレーヤーへの参照ポインタ
- * @param y 目標地点のY座標
- * @param x 目標地点のX座標
- * @param n 現在のコスト
+ * @param y 該当地点のY座標
+ * @param x 該当地点のX座標
  * @param wall プレイヤーが壁の中にいるならばTRUE
+ * @return コスト値、進入できないならTRAVEL_FLOW_BLOCKED、壁の中からだけ進入できるならTRAVEL_FLOW_WALL
  */
-static void travel_flow_aux(player_type *creature_ptr, POSITION y, POSITION x, int n, bool wall)
+static int travel_flow_weight(player_type *creature_ptr, POSITION y, POSITION x, bool wall)
 {
     floor_type *floor_ptr = creature_ptr->current_floor_ptr;
     grid_type *g_ptr = &floor_ptr->grid_array[y][x];
     feature_type *f_ptr = &f_info[g_ptr->feat];
+    if (floor_ptr->dun_level > 0 && !(g_ptr->info & CAVE_KNOWN))
+        return TRAVEL_FLOW_BLOCKED;
+
+    if (f_ptr->flags.has(FF::WALL) || f_ptr->flags.has(FF::CAN_DIG) || (f_ptr->flags.has(FF::DOOR) && g_ptr->mimic)
+        || (f_ptr->flags.has_not(FF::MOVE) && f_ptr->flags.has(FF::CAN_FLY) && !creature_ptr->levitation))
+        return wall ? TRAVEL_FLOW_WALL : TRAVEL_FLOW_BLOCKED;
+
+    return travel_flow_cost(creature_ptr, y, x);
+}
+
+/*!
+ * @brief 隣のグリッドのコストから、グリッドへ進入した時のコストを求める
+ * @param n 隣のグリッドのコスト
+ * @param weight グリッドへ進入するコスト
+ * @return コスト値、進入できないならTRAVEL_FLOW_BLOCKED
+ */
+static int travel_flow_next_cost(int n, int weight)
+{
+    if (weight == TRAVEL_FLOW_BLOCKED)
+        return TRAVEL_FLOW_BLOCKED;
+
+    int add_cost = weight;
+    if (weight == TRAVEL_FLOW_WALL) {
+        if (!(n / TRAVEL_UNABLE))
+            return TRAVEL_FLOW_BLOCKED;
+
+        add_cost = 1 + TRAVEL_UNABLE;
+    }
+
+    return (n % TRAVEL_UNABLE) + add_cost;
+}
+
+/*!
+ * @brief グリッドのコストを下げられるなら下げて計算待ちに積む
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ * @param y 該当地点のY座標
+ * @param x 該当地点のX座標
+ * @param n 隣のグリッドのコスト
+ * @param current 現在処理中のコスト
+ */
+static void travel_flow_relax(floor_type *floor_ptr, POSITION y, POSITION x, int n, int current)
+{
     if (!in_bounds(floor_ptr, y, x))
         return;
 
-    if (floor_ptr->dun_level > 0 && !(g_ptr->info & CAVE_KNOWN))
+    int cost = travel_flow_next_cost(n, travel_flow_cache.weight[y][x]);
+    if ((cost == TRAVEL_FLOW_BLOCKED) || (travel.cost[y][x] <= cost))
         return;
 
-    int add_cost = 1;
-    int from_wall = (n / TRAVEL_UNABLE);
-    if (f_ptr->flags.has(FF::WALL) || f_ptr->flags.has(FF::CAN_DIG) || (f_ptr->flags.has(FF::DOOR) && floor_ptr->grid_array[y][x].mimic)
-        || (f_ptr->flags.has_not(FF::MOVE) && f_ptr->flags.has(FF::CAN_FLY) && !creature_ptr->levitation)) {
-        if (!wall || !from_wall)
-            return;
+    travel.cost[y][x] = cost;
+    size_t bucket = std::max(cost, current);
+    if (travel_flow_buckets.size() <= bucket)
+        travel_flow_buckets.resize(bucket + 1);
 
-        add_cost += TRAVEL_UNABLE;
-    } else
-        add_cost = travel_flow_cost(creature_ptr, y, x);
+    travel_flow_buckets[bucket].push_back({ cost, y, x });
+}
 
-    int base_cost = (n % TRAVEL_UNABLE);
-    int cost = base_cost + add_cost;
-    if (travel.cost[y][x] <= cost)
-        return;
+/*!
+ * @brief 計算待ちのグリッドをコストの小さい順に確定させていく
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ * @details
+ * 進入コストは小さな整数なので、コスト値ごとのバケツを順に見ていけば各グリッドは一度だけ展開される。
+ */
+static void travel_flow_settle(floor_type *floor_ptr)
+{
+    for (size_t current = 0; current < travel_flow_buckets.size(); current++) {
+        for (size_t i = 0; i < travel_flow_buckets[current].size(); i++) {
+            auto entry = travel_flow_buckets[current][i];
+            if (travel.cost[entry.y][entry.x] != entry.cost)
+                continue;
 
-    travel.cost[y][x] = cost;
-    int old_head = flow_head;
-    temp2_y[flow_head] = y;
-    temp2_x[flow_head] = x;
-    if (++flow_head == MAX_SHORT)
-        flow_head = 0;
-
-    if (flow_head == flow_tail)
-        flow_head = old_head;
+            for (DIRECTION d = 0; d < 8; d++)
+                travel_flow_relax(floor_ptr, entry.y + ddy_ddd[d], entry.x + ddx_ddd[d], entry.cost, current);
+        }
+
+        travel_flow_buckets[current].clear();
+    }
+}
+
+/*!
+ * @brief 通りやすくなったグリッドだけを起点にコスト場を直す
+ * @param creature_ptr	プレーヤーへの参照ポインタ
+ * @param changed 通りやすくなったグリッドの一覧
+ */
+static void travel_flow_repair(player_type *creature_ptr, const std::vector<travel_flow_entry_type> &changed)
+{
+    floor_type *floor_ptr = creature_ptr->current_floor_ptr;
+    for (const auto &grid : changed) {
+        if ((grid.y == travel_flow_cache.y) && (grid.x == travel_flow_cache.x))
+            travel_flow_relax(floor_ptr, grid.y, grid.x, 0, 0);
+
+        for (DIRECTION d = 0; d < 8; d++) {
+            POSITION y = grid.y + ddy_ddd[d];
+            POSITION x = grid.x + ddx_ddd[d];
+            if (in_bounds(floor_ptr, y, x) && (travel.cost[y][x] != MAX_SHORT))
+                travel_flow_relax(floor_ptr, grid.y, grid.x, travel.cost[y][x], 0);
+        }
+    }
+
+    travel_flow_settle(floor_ptr);
+}
+
+/*!
+ * @brief 記憶しているコスト場が使えるかを調べ、使えるなら変化したグリッドの分だけ直す
+ * @param creature_ptr	プレーヤーへの参照ポインタ
+ * @param ty 目標地点のY座標
+ * @param tx 目標地点のX座標
+ * @param wall プレイヤーが壁の中にいるならばTRUE
+ * @return 記憶していたコスト場を使えたらTRUE
+ */
+static bool reuse_travel_flow(player_type *creature_ptr, POSITION ty, POSITION tx, bool wall)
+{
+    floor_type *floor_ptr = creature_ptr->current_floor_ptr;
+    auto *cache = &travel_flow_cache;
+    if (!cache->valid || (cache->y != ty) || (cache->x != tx) || (cache->height != floor_ptr->height) || (cache->width != floor_ptr->width)
+        || (cache->in_dungeon != (floor_ptr->dun_level > 0)) || (cache->levitation != creature_ptr->levitation)
+        || (cache->resist_fire != (has_resist_fire(creature_ptr) != 0)) || (cache->wall != wall))
+        return false;
+
+    std::vector<travel_flow_entry_type> changed;
+    for (POSITION y = 0; y < floor_ptr->height; y++) {
+        for (POSITION x = 0; x < floor_ptr->width; x++) {
+            grid_type *g_ptr = &floor_ptr->grid_array[y][x];
+            uint32_t signature = travel_flow_signature(g_ptr);
+            if (cache->signature[y][x] == signature)
+                continue;
+
+            cache->signature[y][x] = signature;
+            int old_weight = cache->weight[y][x];
+            int new_weight = travel_flow_weight(creature_ptr, y, x, wall);
+            if (old_weight == new_weight)
+                continue;
+
+            cache->weight[y][x] = new_weight;
+            bool is_easier = (new_weight >= 0) && ((old_weight == TRAVEL_FLOW_BLOCKED) || ((old_weight >= 0) && (new_weight < old_weight)));
+            if (!is_easier) {
+                cache->valid = false;
+                return false;
+            }
+
+            changed.push_back({ new_weight, y, x });
+        }
+    }
+
+    if (!changed.empty())
+        travel_flow_repair(creature_ptr, changed);
+
+    return true;
 }
 
 /*!
@@ -113,25 +278,43 @@ static void travel_flow_aux(player_type *creature_ptr, POSITION y, POSITION x, i
  */
 static void travel_flow(player_type *creature_ptr, POSITION ty, POSITION tx)
 {
-    flow_head = flow_tail = 0;
+    floor_type *floor_ptr = creature_ptr->current_floor_ptr;
     bool wall = false;
-    feature_type *f_ptr = &f_info[creature_ptr->current_floor_ptr->grid_array[creature_ptr->y][creature_ptr->x].feat];
+    feature_type *f_ptr = &f_info[floor_ptr->grid_array[creature_ptr->y][creature_ptr->x].feat];
     if (f_ptr->flags.has_not(FF::MOVE))
         wall = true;
 
-    travel_flow_aux(creature_ptr, ty, tx, 0, wall);
-    POSITION x, y;
-    while (flow_head != flow_tail) {
-        y = temp2_y[flow_tail];
-        x = temp2_x[flow_tail];
-        if (++flow_tail == MAX_SHORT)
-            flow_tail = 0;
-
-        for (DIRECTION d = 0; d < 8; d++)
-            travel_flow_aux(creature_ptr, y + ddy_ddd[d], x + ddx_ddd[d], travel.cost[y][x], wall);
+    if (reuse_travel_flow(creature_ptr, ty, tx, wall))
+        return;
+
+    forget_travel_flow(floor_ptr);
+    auto *cache = &travel_flow_cache;
+    cache->y = ty;
+    cache->x = tx;
+    cache->height = floor_ptr->height;
+    cache->width = floor_ptr->width;
+    cache->in_dungeon = floor_ptr->dun_level > 0;
+    cache->levitation = creature_ptr->levitation;
+    cache->resist_fire = has_resist_fire(creature_ptr) != 0;
+    cache->wall = wall;
+    for (POSITION y = 0; y < floor_ptr->height; y++) {
+        for (POSITION x = 0; x < floor_ptr->width; x++) {
+            cache->signature[y][x] = travel_flow_signature(&floor_ptr->grid_array[y][x]);
+            cache->weight[y][x] = travel_flow_weight(creature_ptr, y, x, wall);
+        }
     }
 
-    flow_head = flow_tail = 0;
+    travel_flow_relax(floor_ptr, ty, tx, 0, 0);
+    travel_flow_settle(floor_ptr);
+    cache->valid = true;
+}
+
+/*!
+ * @brief 記憶しているトラベルのコスト場を破棄する
+ */
+void forget_travel_flow_cache(void)
+{
+    travel_flow_cache.valid = false;
 }
 
 /*!
@@ -161,7 +344,6 @@ void do_cmd_travel(player_type *creature_ptr)
         return;
     }
 
-    forget_travel_flow(creature_ptr->current_floor_ptr);
     travel_flow(creature_ptr, y, x);
     travel.x = x;
     travel.y = y;
@@ -2,3 +2,4 @@
 
 typedef struct player_type player_type;
 void do_cmd_travel(player_type *creature_ptr);
+void forget_travel_flow_cache(void);
@@ -3,6 +3,7 @@
 #include "core/asking-player.h"
 #include "core/show-file.h"
 #include "game-option/play-record-options.h"
+#include "io/async-file-writer.h"
 #include "io/record-play-movie.h"
 #include "io/files-util.h"
 #include "io/input-key-acceptor.h"
@@ -44,6 +45,7 @@ static void display_diary(player_type *creature_ptr)
     sprintf(diary_title, "Legend of %s %s '%s'", ap_ptr->title, creature_ptr->name, tmp);
 #endif
 
+    flush_async_file_writer();
     (void)show_file(creature_ptr, false, buf, diary_title, -1, 0);
 }
 
@@ -93,6 +95,7 @@ static void do_cmd_erase_diary(void)
         return;
     sprintf(file_name, _("playrecord-%s.txt", "playrec-%s.txt"), savefile_base);
     path_build(buf, sizeof(buf), ANGBAND_DIR_USER, file_name);
+    flush_async_file_writer();
     fd_kill(buf);
 
     fff = angband_fopen(buf, "w");
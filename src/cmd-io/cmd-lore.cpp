@@ -149,7 +149,7 @@ void do_cmd_query_symbol(player_type *creature_ptr)
     query = inkey();
     prt(buf, 0, 0);
     why = 2;
-    ang_sort(creature_ptr, who, &why, n, ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, n, [why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     if (query == 'k') {
         why = 4;
         query = 'y';
@@ -161,7 +161,7 @@ void do_cmd_query_symbol(player_type *creature_ptr)
     }
 
     if (why == 4) {
-        ang_sort(creature_ptr, who, &why, n, ang_sort_comp_hook, ang_sort_swap_hook);
+        ang_sort(who, n, [why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     }
 
     i = n - 1;
@@ -28,6 +28,7 @@
 #include "mind/snipe-types.h"
 #include "monster-floor/monster-death.h"
 #include "monster-floor/monster-move.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags-resistance.h"
 #include "monster-race/race-flags1.h"
@@ -383,6 +384,7 @@ static MULTIPLY calc_shot_damage_with_slay(
  */
 void exe_fire(player_type *shooter_ptr, INVENTORY_IDX item, object_type *j_ptr, SPELL_IDX snipe_type)
 {
+    RandomStreamScope rand_scope(RandomStream::COMBAT);
     DIRECTION dir;
     int i;
     POSITION y, x, ny, nx, ty, tx, prev_y, prev_x;
@@ -806,8 +808,8 @@ void exe_fire(player_type *shooter_ptr, INVENTORY_IDX item, object_type *j_ptr,
                                 if (!is_cave_empty_bold(shooter_ptr, ny, nx))
                                     break;
 
-                                shooter_ptr->current_floor_ptr->grid_array[ny][nx].m_idx = m_idx;
-                                shooter_ptr->current_floor_ptr->grid_array[oy][ox].m_idx = 0;
+                                set_grid_monster(shooter_ptr->current_floor_ptr, ny, nx, m_idx);
+                                set_grid_monster(shooter_ptr->current_floor_ptr, oy, ox, 0);
 
                                 m_ptr->fx = nx;
                                 m_ptr->fy = ny;
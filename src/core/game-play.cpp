@@ -158,8 +158,10 @@ static void init_random_seed(player_type *player_ptr, bool new_game)
     if (!new_game)
         process_player_name(player_ptr);
 
-    if (init_random_seed)
+    if (init_random_seed) {
         Rand_state_init();
+        Rand_streams_init();
+    }
 }
 
 static void init_world_floor_info(player_type *player_ptr)
@@ -13,7 +13,6 @@
 #include "system/player-type-definition.h"
 #include "view/display-messages.h"
 
-#include <algorithm>
 
 /*!
  * @brief グローバルオブジェクト配列の要素番号i1のオブジェクトを要素番号i2に移動する /
@@ -30,7 +29,7 @@ static void compact_objects_aux(floor_type *floor_ptr, OBJECT_IDX i1, OBJECT_IDX
 
     // モンスター所為アイテムリストもしくは床上アイテムリストの要素番号i1をi2に書き換える
     auto &list = get_o_idx_list_contains(floor_ptr, i1);
-    std::replace(list.begin(), list.end(), i1, i2);
+    list.replace(i1, i2);
 
     // 要素番号i1のオブジェクトを要素番号i2に移動
     floor_ptr->o_list[i2] = floor_ptr->o_list[i1];
@@ -9,6 +9,7 @@
 #include "core/stuff-handler.h"
 #include "core/window-redrawer.h"
 #include "dungeon/dungeon.h"
+#include "floor/floor-prefetcher.h"
 #include "floor/floor-save-util.h"
 #include "floor/floor-util.h"
 #include "floor/geometry.h"
@@ -302,6 +303,7 @@ void process_player(player_type *creature_ptr)
             window_stuff(creature_ptr);
 
             can_save = true;
+            prefetch_next_floor(creature_ptr);
             request_command(creature_ptr, false);
             can_save = false;
             process_command(creature_ptr);
@@ -63,10 +63,10 @@ void prevent_turn_overflow(player_type *player_ptr)
         for (int j = 0; j < MAX_STORES; j++) {
             store_type *store_ptr = &town_info[i].store[j];
 
-            if (store_ptr->last_visit > -10L * TURNS_PER_TICK * STORE_TICKS) {
+            if (store_ptr->last_visit > -STORE_MAX_CATCH_UP * TURNS_PER_TICK * STORE_TICKS) {
                 store_ptr->last_visit -= rollback_turns;
-                if (store_ptr->last_visit < -10L * TURNS_PER_TICK * STORE_TICKS)
-                    store_ptr->last_visit = -10L * TURNS_PER_TICK * STORE_TICKS;
+                if (store_ptr->last_visit < -STORE_MAX_CATCH_UP * TURNS_PER_TICK * STORE_TICKS)
+                    store_ptr->last_visit = -STORE_MAX_CATCH_UP * TURNS_PER_TICK * STORE_TICKS;
             }
 
             if (store_ptr->store_open) {
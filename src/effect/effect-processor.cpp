@@ -477,38 +477,7 @@ ProjectResult project(player_type *caster_ptr, const MONSTER_IDX who, POSITION r
             flag &= ~(PROJECT_HIDE);
             breath_shape(caster_ptr, path_g, dist, &grids, gx, gy, gm, &gm_rad, rad, y1, x1, by, bx, typ);
         } else {
-            for (dist = 0; dist <= rad; dist++) {
-                for (y = by - dist; y <= by + dist; y++) {
-                    for (x = bx - dist; x <= bx + dist; x++) {
-                        if (!in_bounds2(caster_ptr->current_floor_ptr, y, x))
-                            continue;
-                        if (distance(by, bx, y, x) != dist)
-                            continue;
-
-                        switch (typ) {
-                        case GF_LITE:
-                        case GF_LITE_WEAK:
-                            if (!los(caster_ptr, by, bx, y, x))
-                                continue;
-                            break;
-                        case GF_DISINTEGRATE:
-                            if (!in_disintegration_range(caster_ptr->current_floor_ptr, by, bx, y, x))
-                                continue;
-                            break;
-                        default:
-                            if (!projectable(caster_ptr, by, bx, y, x))
-                                continue;
-                            break;
-                        }
-
-                        gy[grids] = y;
-                        gx[grids] = x;
-                        grids++;
-                    }
-                }
-
-                gm[dist + 1] = grids;
-            }
+            ball_shape(caster_ptr, &grids, gx, gy, gm, rad, by, bx, typ);
         }
     }
 
@@ -0,0 +1,39 @@
+﻿/*!
+ * @brief 中心からの距離ごとに並べた相対座標テーブル
+ * @date 2026/10/19
+ * @details
+ * monster-dist-offsets.cpp の配列と同じ目的の表を、任意の距離まで計算で求めて保持する。
+ * 各距離の座標は (2*dist+1) 四方を上の行から順に走査した順序で並んでおり、
+ * 「distance() == dist のグリッドを走査する」二重ループをそのまま置き換えられる。
+ */
+
+#include "floor/distance-ring.h"
+#include "floor/geometry.h"
+
+/*!
+ * @brief 計算済の距離別相対座標テーブル / Offsets of the grids, grouped by their distance from the center
+ */
+static std::vector<std::vector<ring_offset_type>> distance_rings;
+
+/*!
+ * @brief 中心から指定距離にあるグリッドの相対座標一覧を返す / Get the offsets of the grids at the given distance from a center
+ * @param dist 中心からの距離
+ * @return 相対座標の一覧 (上の行から順、同じ行の中では左から順)
+ * @details 初回呼び出し時にその距離までの表を計算する。
+ */
+const std::vector<ring_offset_type> &get_distance_ring(POSITION dist)
+{
+    for (POSITION d = static_cast<POSITION>(distance_rings.size()); d <= dist; d++) {
+        std::vector<ring_offset_type> ring;
+        for (POSITION y = -d; y <= d; y++) {
+            for (POSITION x = -d; x <= d; x++) {
+                if (distance(0, 0, y, x) == d)
+                    ring.push_back({ y, x });
+            }
+        }
+
+        distance_rings.push_back(std::move(ring));
+    }
+
+    return distance_rings[dist];
+}
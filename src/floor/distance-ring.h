@@ -0,0 +1,15 @@
+﻿#pragma once
+
+#include "system/angband.h"
+
+#include <vector>
+
+/*!
+ * @brief 中心グリッドからの相対座標 / Offset from a center grid
+ */
+struct ring_offset_type {
+    POSITION y;
+    POSITION x;
+};
+
+const std::vector<ring_offset_type> &get_distance_ring(POSITION dist);
@@ -45,3 +45,21 @@
  * Maximum dungeon width in grids, must be a multiple of SCREEN_WID, probably hard-coded to SCREEN_WID * 3.
  */
 #define MAX_WID 198
+
+/*!
+ * @brief モンスターの位置索引で用いる区画の一辺のグリッド数
+ * Number of grids on each side of a block of the monster spatial index
+ */
+#define MONSTER_BLOCK_SIZE 8
+
+/*!
+ * @brief モンスターの位置索引の区画数(垂直方向)
+ * Number of blocks of the monster spatial index (vertically)
+ */
+#define MONSTER_BLOCK_HGT ((MAX_HGT + MONSTER_BLOCK_SIZE - 1) / MONSTER_BLOCK_SIZE)
+
+/*!
+ * @brief モンスターの位置索引の区画数(水平方向)
+ * Number of blocks of the monster spatial index (horizontally)
+ */
+#define MONSTER_BLOCK_WID ((MAX_WID + MONSTER_BLOCK_SIZE - 1) / MONSTER_BLOCK_SIZE)
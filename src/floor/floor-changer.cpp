@@ -7,6 +7,7 @@
 #include "floor/floor-generator.h"
 #include "floor/floor-mode-changer.h"
 #include "floor/floor-object.h"
+#include "floor/floor-prefetcher.h"
 #include "floor/floor-save-util.h"
 #include "floor/floor-save.h"
 #include "floor/floor-util.h"
@@ -20,6 +21,7 @@
 #include "main/sound-of-music.h"
 #include "monster-floor/monster-generator.h"
 #include "monster-floor/monster-remover.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-floor/monster-summon.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
@@ -42,6 +44,7 @@
 #include "system/monster-race-definition.h"
 #include "system/object-type-definition.h"
 #include "system/player-type-definition.h"
+#include "target/projection-path-calculator.h"
 #include "view/display-messages.h"
 #include "window/main-window-util.h"
 #include "world/world.h"
@@ -99,7 +102,7 @@ static MONSTER_IDX decide_pet_index(player_type *master_ptr, const int current_m
 static void set_pet_params(player_type *master_ptr, monster_race **r_ptr, const int current_monster, MONSTER_IDX m_idx, const POSITION cy, const POSITION cx)
 {
     monster_type *m_ptr = &master_ptr->current_floor_ptr->m_list[m_idx];
-    master_ptr->current_floor_ptr->grid_array[cy][cx].m_idx = m_idx;
+    set_grid_monster(master_ptr->current_floor_ptr, cy, cx, m_idx);
     m_ptr->r_idx = party_mon[current_monster].r_idx;
     *m_ptr = party_mon[current_monster];
     *r_ptr = real_r_ptr(m_ptr);
@@ -285,10 +288,22 @@ static void new_floor_allocation(player_type *creature_ptr, saved_floor_type *sf
         (void)alloc_monster(creature_ptr, 0, 0, summon_specific);
 }
 
+/*!
+ * @brief 新しいフロアを生成する。先行生成済のフロアが使えるならそれに差し替える
+ * @param creature_ptr プレーヤーへの参照ポインタ
+ */
+static void generate_new_floor(player_type *creature_ptr)
+{
+    if (install_prefetched_floor(creature_ptr))
+        return;
+
+    generate_floor(creature_ptr);
+}
+
 static void check_dead_end(player_type *creature_ptr, saved_floor_type *sf_ptr)
 {
     if (sf_ptr->last_visit == 0) {
-        generate_floor(creature_ptr);
+        generate_new_floor(creature_ptr);
         return;
     }
 
@@ -342,7 +357,7 @@ static void cut_off_the_upstair(player_type *creature_ptr)
 static void update_floor(player_type *creature_ptr)
 {
     if (!(creature_ptr->change_floor_mode & CFM_SAVE_FLOORS) && !(creature_ptr->change_floor_mode & CFM_FIRST_FLOOR)) {
-        generate_floor(creature_ptr);
+        generate_new_floor(creature_ptr);
         new_floor_id = 0;
         return;
     }
@@ -378,8 +393,10 @@ void change_floor(player_type *creature_ptr)
     panel_col_max = 0;
     creature_ptr->ambush_flag = false;
     update_floor(creature_ptr);
+    discard_prefetched_floor();
     place_pet(creature_ptr);
     forget_travel_flow(creature_ptr->current_floor_ptr);
+    forget_projectable_field();
     update_unique_artifact(creature_ptr->current_floor_ptr, new_floor_id);
     creature_ptr->floor_id = new_floor_id;
     current_world_ptr->character_dungeon = true;
@@ -31,6 +31,7 @@
 #include "market/arena-info-table.h"
 #include "monster-floor/monster-generator.h"
 #include "monster-floor/monster-remover.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-floor/place-monster-types.h"
 #include "monster-race/monster-race.h"
 #include "monster/monster-flag-types.h"
@@ -351,7 +352,7 @@ void clear_cave(player_type *player_ptr)
             g_ptr->info = 0;
             g_ptr->feat = 0;
             g_ptr->o_idx_list.clear();
-            g_ptr->m_idx = 0;
+            set_grid_monster(floor_ptr, y, x, 0);
             g_ptr->special = 0;
             g_ptr->mimic = 0;
             memset(g_ptr->costs, 0, sizeof(g_ptr->costs));
@@ -455,6 +456,7 @@ static bool floor_is_connected(const floor_type *const floor_ptr, const IsWallFu
  */
 void generate_floor(player_type *player_ptr)
 {
+    RandomStreamScope rand_scope(RandomStream::GENERATION);
     floor_type *floor_ptr = player_ptr->current_floor_ptr;
     floor_ptr->dungeon_idx = player_ptr->dungeon_idx;
     set_floor_and_wall(floor_ptr->dungeon_idx);
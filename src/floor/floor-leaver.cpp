@@ -19,6 +19,7 @@
 #include "mind/mind-ninja.h"
 #include "monster-floor/monster-lite.h"
 #include "monster-floor/monster-remover.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
 #include "monster-race/race-flags7.h"
@@ -235,8 +236,8 @@ static void get_out_monster(player_type *protected_ptr)
             continue;
 
         m_ptr = &floor_ptr->m_list[m_idx];
-        floor_ptr->grid_array[oy][ox].m_idx = 0;
-        floor_ptr->grid_array[ny][nx].m_idx = m_idx;
+        set_grid_monster(floor_ptr, oy, ox, 0);
+        set_grid_monster(floor_ptr, ny, nx, m_idx);
         m_ptr->fy = ny;
         m_ptr->fx = nx;
         return;
@@ -186,9 +186,9 @@ void delete_all_items_from_floor(player_type *player_ptr, POSITION y, POSITION x
         return;
 
     g_ptr = &floor_ptr->grid_array[y][x];
-    for (const auto this_o_idx : g_ptr->o_idx_list) {
+    for (auto it = g_ptr->o_idx_list.begin(); it != g_ptr->o_idx_list.end();) {
         object_type *o_ptr;
-        o_ptr = &floor_ptr->o_list[this_o_idx];
+        o_ptr = &floor_ptr->o_list[*it++];
         o_ptr->wipe();
         floor_ptr->o_cnt--;
     }
@@ -0,0 +1,430 @@
+﻿/*!
+ * @brief 次フロアの先行生成 / Pre-generation of the next dungeon level
+ * @date 2026/10/19
+ * @details
+ * コマンド入力待ちの間に、現在のダンジョンの1階下のフロアを予備のfloor_type上に生成しておく。
+ * フロア生成は乱数やr_info/a_infoの生成数、画面パネル等のグローバル状態に依存しているため別スレッドでは行えない。
+ * そのため入力待ちに入る直前にメインスレッドで生成し、生成によって変化するグローバル状態は乱数も含めて全て元に戻す。
+ * 新しいフロアへ移動する際、生成条件 (ダンジョン・階層・クエスト・ユニークやアーティファクトの生存状況) と
+ * フロア生成用の乱数列の位置が変わっていなければ予備フロアと差し替えて乱数列を生成後の位置まで進め、
+ * 変わっていれば破棄して通常通り生成させる。従って待機したか否かでゲームの乱数列は変わらない。
+ */
+
+#include "floor/floor-prefetcher.h"
+#include "dungeon/dungeon.h"
+#include "dungeon/quest.h"
+#include "floor/floor-generator.h"
+#include "floor/floor-save-util.h"
+#include "floor/floor-save.h"
+#include "floor/wild.h"
+#include "game-option/game-play-options.h"
+#include "io/input-key-acceptor.h"
+#include "monster-race/monster-race.h"
+#include "monster-race/race-flags1.h"
+#include "monster-race/race-flags7.h"
+#include "monster/monster-info.h"
+#include "monster/monster-status.h"
+#include "object-hook/hook-checker.h"
+#include "object-hook/hook-enchant.h"
+#include "system/artifact-type-definition.h"
+#include "system/floor-type-definition.h"
+#include "system/grid-type-definition.h"
+#include "system/monster-race-definition.h"
+#include "system/monster-type-definition.h"
+#include "system/object-type-definition.h"
+#include "system/player-type-definition.h"
+#include "target/target-checker.h"
+#include "term/z-rand.h"
+#include "term/z-term.h"
+#include "window/main-window-util.h"
+#include "world/world.h"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace {
+/*!
+ * @brief 先行生成したフロアとその生成条件
+ */
+struct prefetched_floor_type {
+    floor_type floor{}; //!< 先行生成先の予備フロア
+    bool allocated{}; //!< 予備フロアの各配列を確保済ならtrue
+    bool attempted{}; //!< 現在のフロアで先行生成を試みたならtrue
+    bool valid{}; //!< 差し替え可能なフロアを保持しているならtrue
+    DUNGEON_IDX dungeon_idx{}; //!< 生成したダンジョンID
+    DEPTH dun_level{}; //!< 生成した階層
+    QUEST_IDX lower_quest{}; //!< 生成時点での更に1階下のクエストID (下り階段の配置に影響する)
+    POSITION y{}; //!< 生成時に決まったプレイヤーの初期位置
+    POSITION x{}; //!< 生成時に決まったプレイヤーの初期位置
+    uint32_t rand_state_before[4]{}; //!< 生成開始時のフロア生成用乱数の状態
+    uint32_t rand_state_after[4]{}; //!< 生成終了時のフロア生成用乱数の状態
+};
+
+/*!
+ * @brief 生成のやり直し (wipe_monsters_list()) で変化しうるモンスター種族の数値
+ */
+struct race_counts_type {
+    MONSTER_NUMBER cur_num{};
+    MONSTER_NUMBER max_num{};
+    MONSTER_NUMBER r_pkills{};
+    MONSTER_NUMBER r_akills{};
+    MONSTER_NUMBER r_tkills{};
+};
+
+/*!
+ * @brief 先行生成中に退避しておくグローバル状態
+ */
+struct prefetch_context_type {
+    floor_type *floor_ptr{};
+    POSITION y{};
+    POSITION x{};
+    bool enter_dungeon{};
+    BIT_FLAGS update{};
+    BIT_FLAGS redraw{};
+    BIT_FLAGS window_flags{};
+    POSITION panel_row_min{};
+    POSITION panel_row_max{};
+    POSITION panel_col_min{};
+    POSITION panel_col_max{};
+    POSITION panel_row_prt{};
+    POSITION panel_col_prt{};
+    bool character_dungeon{};
+    MONSTER_IDX target_who{};
+    MONSTER_IDX pet_t_m_idx{};
+    MONSTER_IDX riding_t_m_idx{};
+    MONSTER_IDX health_who{};
+    uint32_t rand_state[4]{};
+    uint32_t generation_rand_state[4]{};
+    std::vector<race_counts_type> r_counts;
+    std::vector<byte> a_cur_nums;
+};
+
+prefetched_floor_type prefetched;
+}
+
+/*!
+ * @brief 予備フロアの各配列を確保する
+ * @param floor_ptr 予備フロアへの参照ポインタ
+ * @details init_other() で確保されるフロアと同じ大きさを確保する
+ */
+static void allocate_prefetch_floor(floor_type *floor_ptr)
+{
+    C_MAKE(floor_ptr->o_list, current_world_ptr->max_o_idx, object_type);
+    C_MAKE(floor_ptr->m_list, current_world_ptr->max_m_idx, monster_type);
+    for (int i = 0; i < MAX_MTIMED; i++)
+        C_MAKE(floor_ptr->mproc_list[i], current_world_ptr->max_m_idx, int16_t);
+
+    for (int i = 0; i < MAX_HGT; i++)
+        C_MAKE(floor_ptr->grid_array[i], MAX_WID, grid_type);
+}
+
+/*!
+ * @brief 現在のフロアが先行生成を行えるフロアかを返す
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @return 通常のダンジョン階で、1階下が存在するならtrue
+ */
+static bool is_prefetchable_floor(player_type *player_ptr)
+{
+    floor_type *floor_ptr = player_ptr->current_floor_ptr;
+    if (!current_world_ptr->character_dungeon || player_ptr->wild_mode || player_ptr->phase_out)
+        return false;
+
+    if ((floor_ptr->dun_level <= 0) || floor_ptr->inside_quest || floor_ptr->inside_arena)
+        return false;
+
+    return (player_ptr->dungeon_idx == floor_ptr->dungeon_idx) && (floor_ptr->dun_level < d_info[floor_ptr->dungeon_idx].maxdepth);
+}
+
+/*!
+ * @brief 先行生成で変化するグローバル状態を退避し、生成中に画面やメッセージへ影響しないようにする
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @param context 退避先
+ */
+static void save_prefetch_context(player_type *player_ptr, prefetch_context_type *context)
+{
+    context->floor_ptr = player_ptr->current_floor_ptr;
+    context->y = player_ptr->y;
+    context->x = player_ptr->x;
+    context->enter_dungeon = player_ptr->enter_dungeon;
+    context->update = player_ptr->update;
+    context->redraw = player_ptr->redraw;
+    context->window_flags = player_ptr->window_flags;
+    context->panel_row_min = panel_row_min;
+    context->panel_row_max = panel_row_max;
+    context->panel_col_min = panel_col_min;
+    context->panel_col_max = panel_col_max;
+    context->panel_row_prt = panel_row_prt;
+    context->panel_col_prt = panel_col_prt;
+    context->character_dungeon = current_world_ptr->character_dungeon;
+    context->target_who = target_who;
+    context->pet_t_m_idx = player_ptr->pet_t_m_idx;
+    context->riding_t_m_idx = player_ptr->riding_t_m_idx;
+    context->health_who = player_ptr->health_who;
+    Rand_state_backup(context->rand_state);
+    std::copy_n(Rand_stream(RandomStream::GENERATION), 4, context->generation_rand_state);
+    context->r_counts.clear();
+    for (const auto &r_ref : r_info)
+        context->r_counts.push_back({ r_ref.cur_num, r_ref.max_num, r_ref.r_pkills, r_ref.r_akills, r_ref.r_tkills });
+
+    context->a_cur_nums.clear();
+    for (const auto &a_ref : a_info)
+        context->a_cur_nums.push_back(a_ref.cur_num);
+
+    /* 生成中のlite_spot()が予備フロアを描画しないよう、どのマスも画面に含まれない状態にする */
+    panel_row_max = -1;
+    panel_col_max = -1;
+    player_ptr->enter_dungeon = false;
+    current_world_ptr->character_dungeon = false;
+    current_world_ptr->is_prefetching_floor = true;
+}
+
+/*!
+ * @brief 退避しておいたグローバル状態を元に戻す
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @param context 退避元
+ * @details
+ * 生成のやり直しで呼ばれる wipe_monsters_list() はターゲットや体力表示、バーノール・ルパートの数値を変えるが、
+ * 通常の階移動では生成前に同じ関数が呼ばれるため、差し替え時にこれらをやり直す必要はない。
+ */
+static void restore_prefetch_context(player_type *player_ptr, prefetch_context_type *context)
+{
+    current_world_ptr->is_prefetching_floor = false;
+    current_world_ptr->character_dungeon = context->character_dungeon;
+    Rand_state_restore(context->rand_state);
+    std::copy_n(context->generation_rand_state, 4, Rand_stream(RandomStream::GENERATION));
+    for (size_t i = 0; i < context->r_counts.size(); i++) {
+        const auto &counts = context->r_counts[i];
+        r_info[i].cur_num = counts.cur_num;
+        r_info[i].max_num = counts.max_num;
+        r_info[i].r_pkills = counts.r_pkills;
+        r_info[i].r_akills = counts.r_akills;
+        r_info[i].r_tkills = counts.r_tkills;
+    }
+
+    for (size_t i = 0; i < context->a_cur_nums.size(); i++)
+        a_info[i].cur_num = context->a_cur_nums[i];
+
+    panel_row_min = context->panel_row_min;
+    panel_row_max = context->panel_row_max;
+    panel_col_min = context->panel_col_min;
+    panel_col_max = context->panel_col_max;
+    panel_row_prt = context->panel_row_prt;
+    panel_col_prt = context->panel_col_prt;
+    player_ptr->current_floor_ptr = context->floor_ptr;
+    player_ptr->y = context->y;
+    player_ptr->x = context->x;
+    player_ptr->enter_dungeon = context->enter_dungeon;
+    player_ptr->update = context->update;
+    player_ptr->redraw = context->redraw;
+    player_ptr->window_flags = context->window_flags;
+    target_who = context->target_who;
+    player_ptr->pet_t_m_idx = context->pet_t_m_idx;
+    player_ptr->riding_t_m_idx = context->riding_t_m_idx;
+    player_ptr->health_who = context->health_who;
+    set_floor_and_wall(context->floor_ptr->dungeon_idx);
+}
+
+/*!
+ * @brief 入力待ちの間に1階下のフロアを先行生成する / Pre-generate the next level while waiting for a command
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @details
+ * 先行生成は1フロアにつき1回だけ試みる。
+ * 既にキー入力が溜まっている場合は、プレイヤーの操作を待たせないよう次の入力待ちまで見送る。
+ */
+void prefetch_next_floor(player_type *player_ptr)
+{
+    if (!prefetch_floors || prefetched.attempted || !is_prefetchable_floor(player_ptr))
+        return;
+
+    if (inkey_next && *inkey_next)
+        return;
+
+    term_fresh();
+    char ch;
+    if (term_inkey(&ch, false, false) == 0)
+        return;
+
+    prefetched.attempted = true;
+    if (!prefetched.allocated) {
+        allocate_prefetch_floor(&prefetched.floor);
+        prefetched.allocated = true;
+    }
+
+    floor_type *floor_ptr = &prefetched.floor;
+    floor_ptr->dun_level = player_ptr->current_floor_ptr->dun_level + 1;
+    floor_ptr->inside_quest = 0;
+    floor_ptr->inside_arena = false;
+
+    prefetch_context_type context;
+    save_prefetch_context(player_ptr, &context);
+    player_ptr->current_floor_ptr = floor_ptr;
+    if (quest_number(player_ptr, floor_ptr->dun_level) == 0) {
+        std::copy_n(Rand_stream(RandomStream::GENERATION), 4, prefetched.rand_state_before);
+        generate_floor(player_ptr);
+        std::copy_n(Rand_stream(RandomStream::GENERATION), 4, prefetched.rand_state_after);
+        prefetched.valid = true;
+        prefetched.dungeon_idx = floor_ptr->dungeon_idx;
+        prefetched.dun_level = floor_ptr->dun_level;
+        prefetched.lower_quest = quest_number(player_ptr, floor_ptr->dun_level + 1);
+        prefetched.y = player_ptr->y;
+        prefetched.x = player_ptr->x;
+    }
+
+    restore_prefetch_context(player_ptr, &context);
+}
+
+/*!
+ * @brief 移動先のフロアが先行生成時と同じ条件で生成されるかを返す
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @return 同じ条件ならtrue
+ */
+static bool is_same_generation_inputs(player_type *player_ptr)
+{
+    floor_type *floor_ptr = player_ptr->current_floor_ptr;
+    if (player_ptr->wild_mode || player_ptr->phase_out || player_ptr->enter_dungeon || floor_ptr->inside_quest || floor_ptr->inside_arena)
+        return false;
+
+    if ((player_ptr->dungeon_idx != prefetched.dungeon_idx) || (floor_ptr->dun_level != prefetched.dun_level))
+        return false;
+
+    if (!std::equal(prefetched.rand_state_before, prefetched.rand_state_before + 4, Rand_stream(RandomStream::GENERATION)))
+        return false;
+
+    return (quest_number(player_ptr, floor_ptr->dun_level) == 0) && (quest_number(player_ptr, floor_ptr->dun_level + 1) == prefetched.lower_quest);
+}
+
+/*!
+ * @brief 先行生成したフロアのユニークモンスターが現在も配置可能かを返す
+ * @return 同行するペットと合わせても各種族の最大数を超えないならtrue
+ * @details 先行生成後に倒されたユニークや、ペットとして連れてきたユニークがいれば差し替えできない
+ */
+static bool can_take_over_uniques(void)
+{
+    std::map<monster_race *, int> nums;
+    floor_type *floor_ptr = &prefetched.floor;
+    for (MONSTER_IDX i = 1; i < floor_ptr->m_max; i++) {
+        monster_type *m_ptr = &floor_ptr->m_list[i];
+        if (monster_is_valid(m_ptr))
+            nums[real_r_ptr(m_ptr)]++;
+    }
+
+    for (auto &party_ref : party_mon) {
+        if (!monster_is_valid(&party_ref))
+            continue;
+
+        auto it = nums.find(real_r_ptr(&party_ref));
+        if (it != nums.end())
+            it->second++;
+    }
+
+    for (const auto &[r_ptr, num] : nums) {
+        if (((r_ptr->flags1 & RF1_UNIQUE) || (r_ptr->flags7 & RF7_NAZGUL)) && (num > r_ptr->max_num))
+            return false;
+
+        if ((r_ptr->flags7 & RF7_UNIQUE2) && (num > 1))
+            return false;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 先行生成したフロアの固定アーティファクトが、その後どこかで生成されていないかを返す
+ * @return 全て未生成ならtrue
+ */
+static bool can_take_over_artifacts(void)
+{
+    floor_type *floor_ptr = &prefetched.floor;
+    for (OBJECT_IDX i = 1; i < floor_ptr->o_max; i++) {
+        object_type *o_ptr = &floor_ptr->o_list[i];
+        if (object_is_valid(o_ptr) && object_is_fixed_artifact(o_ptr) && a_info[o_ptr->name1].cur_num)
+            return false;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief フロアの生成結果だけを入れ替える
+ * @details 視界や光源の配列、生成ターン等は入れ替えずに移動先のフロアのものを使う
+ */
+static void swap_floor_contents(floor_type *floor_ptr, floor_type *other_ptr)
+{
+    std::swap(floor_ptr->dungeon_idx, other_ptr->dungeon_idx);
+    std::swap(floor_ptr->grid_array, other_ptr->grid_array);
+    std::swap(floor_ptr->dun_level, other_ptr->dun_level);
+    std::swap(floor_ptr->base_level, other_ptr->base_level);
+    std::swap(floor_ptr->object_level, other_ptr->object_level);
+    std::swap(floor_ptr->monster_level, other_ptr->monster_level);
+    std::swap(floor_ptr->width, other_ptr->width);
+    std::swap(floor_ptr->height, other_ptr->height);
+    std::swap(floor_ptr->num_repro, other_ptr->num_repro);
+    std::swap(floor_ptr->o_list, other_ptr->o_list);
+    std::swap(floor_ptr->o_max, other_ptr->o_max);
+    std::swap(floor_ptr->o_cnt, other_ptr->o_cnt);
+    std::swap(floor_ptr->m_list, other_ptr->m_list);
+    std::swap(floor_ptr->m_max, other_ptr->m_max);
+    std::swap(floor_ptr->m_cnt, other_ptr->m_cnt);
+    std::swap(floor_ptr->mon_block_num, other_ptr->mon_block_num);
+    std::swap(floor_ptr->mon_block_total, other_ptr->mon_block_total);
+    std::swap(floor_ptr->mproc_list, other_ptr->mproc_list);
+    std::swap(floor_ptr->mproc_max, other_ptr->mproc_max);
+    std::swap(floor_ptr->monster_noise, other_ptr->monster_noise);
+    std::swap(floor_ptr->inside_quest, other_ptr->inside_quest);
+    std::swap(floor_ptr->inside_arena, other_ptr->inside_arena);
+}
+
+/*!
+ * @brief 先行生成したフロアを移動先のフロアとして使う / Take over the pre-generated level
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @return 差し替えたならtrue、条件が合わず破棄したならfalse (呼び出し元で通常通り生成すること)
+ * @details
+ * generate_floor() の代わりに呼ぶ。生成時に行われるr_info/a_infoの生成数の更新はここでやり直し、
+ * フロア生成用の乱数列も生成後の位置まで進める。
+ */
+bool install_prefetched_floor(player_type *player_ptr)
+{
+    if (!prefetched.valid)
+        return false;
+
+    prefetched.valid = false;
+    if (!is_same_generation_inputs(player_ptr) || !can_take_over_uniques() || !can_take_over_artifacts())
+        return false;
+
+    floor_type *floor_ptr = player_ptr->current_floor_ptr;
+    swap_floor_contents(floor_ptr, &prefetched.floor);
+    for (int i = 1; i < max_r_idx; i++)
+        r_info[i].cur_num = 0;
+
+    precalc_cur_num_of_pet(player_ptr);
+    for (MONSTER_IDX i = 1; i < floor_ptr->m_max; i++) {
+        monster_type *m_ptr = &floor_ptr->m_list[i];
+        if (!monster_is_valid(m_ptr))
+            continue;
+
+        m_ptr->current_floor_ptr = floor_ptr;
+        real_r_ptr(m_ptr)->cur_num++;
+    }
+
+    for (OBJECT_IDX i = 1; i < floor_ptr->o_max; i++) {
+        object_type *o_ptr = &floor_ptr->o_list[i];
+        if (object_is_valid(o_ptr) && object_is_fixed_artifact(o_ptr))
+            a_info[o_ptr->name1].cur_num = 1;
+    }
+
+    std::copy_n(prefetched.rand_state_after, 4, Rand_stream(RandomStream::GENERATION));
+    set_floor_and_wall(floor_ptr->dungeon_idx);
+    player_ptr->y = prefetched.y;
+    player_ptr->x = prefetched.x;
+    player_ptr->enter_dungeon = false;
+    return true;
+}
+
+/*!
+ * @brief 先行生成したフロアを破棄し、次のフロアで再び先行生成できるようにする
+ */
+void discard_prefetched_floor(void)
+{
+    prefetched.valid = false;
+    prefetched.attempted = false;
+}
@@ -0,0 +1,6 @@
+﻿#pragma once
+
+typedef struct player_type player_type;
+void prefetch_next_floor(player_type *player_ptr);
+bool install_prefetched_floor(player_type *player_ptr);
+void discard_prefetched_floor(void);
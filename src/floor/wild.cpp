@@ -47,6 +47,7 @@
 #include "view/display-messages.h"
 #include "window/main-window-util.h"
 #include "world/world.h"
+#include <vector>
 
 #define MAX_FEAT_IN_TERRAIN 18
 
@@ -212,12 +213,54 @@ static void plasma_recursive(floor_type *floor_ptr, POSITION x1, POSITION y1, PO
 /* The default table in terrain level generation. */
 static int16_t terrain_table[MAX_WILDERNESS][MAX_FEAT_IN_TERRAIN];
 
+#define WILDERNESS_LAYER_CACHE_SIZE 25 /*!< 生成済み地形を覚えておく荒野区画の数 */
+
+/*!
+ * @brief 生成済みの荒野区画の地形
+ * @details
+ * 荒野区画の地形は地形IDとシードだけで決まるため、生成した結果を覚えておけば再生成の代わりに複写できる。
+ */
+struct wilderness_layer_type {
+    int terrain = -1; //!< 地形ID (-1なら未使用)
+    uint32_t seed = 0; //!< 乱数の固定シード
+    uint32_t last_used = 0; //!< 最後に使った時の通し番号
+    std::vector<FEAT_IDX> feat; //!< 全マスの地形 (MAX_HGT * MAX_WID)
+};
+
+static wilderness_layer_type wilderness_layers[WILDERNESS_LAYER_CACHE_SIZE];
+static uint32_t wilderness_layer_clock = 0;
+
+/*!
+ * @brief 生成済みの荒野区画の地形を探す
+ * @param terrain 荒野地形ID
+ * @param seed 乱数の固定シード
+ * @return 見つかった区画。なければ最も長く使われていない区画を空けて返す
+ */
+static wilderness_layer_type *find_wilderness_layer(int terrain, uint32_t seed)
+{
+    wilderness_layer_type *oldest = &wilderness_layers[0];
+    for (auto &layer : wilderness_layers) {
+        if ((layer.terrain == terrain) && (layer.seed == seed)) {
+            layer.last_used = ++wilderness_layer_clock;
+            return &layer;
+        }
+
+        if (layer.last_used < oldest->last_used)
+            oldest = &layer;
+    }
+
+    oldest->terrain = -1;
+    oldest->last_used = ++wilderness_layer_clock;
+    return oldest;
+}
+
 /*!
  * @brief 荒野フロア生成のサブルーチン
  * @param terrain 荒野地形ID
  * @param seed 乱数の固定シード
  * @param border 未使用
  * @param corner 広域マップの角部分としての生成ならばTRUE
+ * @details 角以外の生成結果は覚えておき、同じ区画を再び生成する時は複写で済ませる。
  */
 static void generate_wilderness_area(floor_type *floor_ptr, int terrain, uint32_t seed, bool corner)
 {
@@ -229,6 +272,18 @@ static void generate_wilderness_area(floor_type *floor_ptr, int terrain, uint32_
         return;
     }
 
+    wilderness_layer_type *layer = nullptr;
+    if (!corner) {
+        layer = find_wilderness_layer(terrain, seed);
+        if (layer->terrain == terrain) {
+            for (POSITION y1 = 0; y1 < MAX_HGT; y1++)
+                for (POSITION x1 = 0; x1 < MAX_WID; x1++)
+                    floor_ptr->grid_array[y1][x1].feat = layer->feat[y1 * MAX_WID + x1];
+
+            return;
+        }
+    }
+
     uint32_t state_backup[4];
     Rand_state_backup(state_backup);
     Rand_state_set(seed);
@@ -266,6 +321,13 @@ static void generate_wilderness_area(floor_type *floor_ptr, int terrain, uint32_
             floor_ptr->grid_array[y1][x1].feat = terrain_table[terrain][floor_ptr->grid_array[y1][x1].feat];
 
     Rand_state_restore(state_backup);
+    layer->feat.resize(MAX_HGT * MAX_WID);
+    for (POSITION y1 = 0; y1 < MAX_HGT; y1++)
+        for (POSITION x1 = 0; x1 < MAX_WID; x1++)
+            layer->feat[y1 * MAX_WID + x1] = floor_ptr->grid_array[y1][x1].feat;
+
+    layer->terrain = terrain;
+    layer->seed = seed;
 }
 
 /*!
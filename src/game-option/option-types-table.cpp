@@ -152,6 +152,8 @@ const std::array<const option_type, MAX_OPTION_INFO> option_info = {{
 
     { &bound_walls_perm, true, OPT_PAGE_GAMEPLAY, 2, 1, "bound_walls_perm", _("ダンジョンの外壁を永久岩にする", "Boundary walls become 'permanent wall'") },
 
+    { &prefetch_floors, false, OPT_PAGE_GAMEPLAY, 2, 2, "prefetch_floors", _("待機中に次の階を先行生成する", "Pre-generate the next level while idle") },
+
     { &last_words, true, OPT_PAGE_GAMEPLAY, 0, 28, "last_words", _("キャラクターが死んだ時遺言をのこす", "Leave last words when your character dies") },
 
     { &auto_dump, false, OPT_PAGE_GAMEPLAY, 4, 5, "auto_dump", _("自動的にキャラクターの記録をファイルに書き出す", "Dump a character record automatically") },
@@ -23,7 +23,7 @@ struct option_type {
     concptr o_desc{};
 };
 
-#define MAX_OPTION_INFO 126
+#define MAX_OPTION_INFO 127
 #define MAX_CHEAT_OPTIONS 11
 #define MAX_AUTOSAVE_INFO 2
 
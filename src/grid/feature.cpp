@@ -14,6 +14,7 @@
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h" // @todo 相互依存している. 後で何とかする.
 #include "system/player-type-definition.h"
+#include "target/projection-path-calculator.h"
 #include "util/bit-flags-calculator.h"
 #include "world/world.h"
 
@@ -223,6 +224,7 @@ void cave_set_feat(player_type *player_ptr, POSITION y, POSITION x, FEAT_IDX fea
     }
 
     bool old_los = cave_has_flag_bold(floor_ptr, y, x, FF::LOS);
+    bool old_project = cave_has_flag_bold(floor_ptr, y, x, FF::PROJECT);
     bool old_mirror = g_ptr->is_mirror();
 
     g_ptr->mimic = 0;
@@ -245,6 +247,8 @@ void cave_set_feat(player_type *player_ptr, POSITION y, POSITION x, FEAT_IDX fea
     lite_spot(player_ptr, y, x);
     if (old_los ^ f_ptr->flags.has(FF::LOS))
         player_ptr->update |= PU_VIEW | PU_LITE | PU_MON_LITE | PU_MONSTERS;
+    if (old_project ^ f_ptr->flags.has(FF::PROJECT))
+        forget_projectable_field();
 
     if (f_ptr->flags.has_not(FF::GLOW) || d_info[player_ptr->dungeon_idx].flags.has(DF::DARKNESS))
         return;
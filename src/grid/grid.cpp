@@ -378,6 +378,7 @@ void note_spot(player_type *player_ptr, POSITION y, POSITION x)
 
     /* Memorize terrain of the grid */
     g_ptr->info |= (CAVE_KNOWN);
+    invalidate_map_info_cache(player_ptr->current_floor_ptr, y, x);
 }
 
 /*
@@ -387,6 +388,9 @@ void note_spot(player_type *player_ptr, POSITION y, POSITION x)
  */
 void lite_spot(player_type *player_ptr, POSITION y, POSITION x)
 {
+    if (in_bounds2(player_ptr->current_floor_ptr, y, x))
+        invalidate_map_info_cache(player_ptr->current_floor_ptr, y, x);
+
     /* Redraw if on screen */
     if (panel_contains(y, x) && in_bounds2(player_ptr->current_floor_ptr, y, x)) {
         TERM_COLOR a;
@@ -394,7 +398,7 @@ void lite_spot(player_type *player_ptr, POSITION y, POSITION x)
         TERM_COLOR ta;
         SYMBOL_CODE tc;
 
-        map_info(player_ptr, y, x, &a, &c, &ta, &tc);
+        map_info_cached(player_ptr, y, x, &a, &c, &ta, &tc);
 
         /* Hack -- fake monochrome */
         if (!use_graphics) {
@@ -22,6 +22,11 @@
 #include "util/string-processor.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 static char tmp[8];
 static concptr variant = "ZANGBAND";
@@ -222,6 +227,87 @@ static concptr parse_fixed_map_expression(player_type *player_ptr, char **sp, ch
     return v;
 }
 
+namespace {
+/*!
+ * @brief 固定マップファイル中の1行
+ */
+struct fixed_map_line_type {
+    int line_num; //!< ファイル上の行番号 (0始まり)
+    bool is_condition; //!< ?:による条件行か否か
+    size_t next_condition; //!< 次の条件行の添字 (なければ行数)
+    std::string text; //!< 行の内容
+};
+
+/*!
+ * @brief 読み込み済みの固定マップファイル
+ */
+struct fixed_map_file_type {
+    time_t mtime; //!< 読み込んだ時点のファイルの更新時刻
+    std::vector<fixed_map_line_type> lines; //!< 空行とコメントを除いた行
+};
+
+/*!
+ * @brief 固定マップファイルを読み込む
+ * @param path ファイルパス
+ * @param mtime ファイルの更新時刻
+ * @return 読み込んだファイル。開けなければnullptr
+ * @details
+ * 空行・コメント行は捨て、条件行には次の条件行の位置を持たせておく。
+ * 条件が偽の区間は解釈の際にまとめて読み飛ばせる。
+ */
+std::shared_ptr<const fixed_map_file_type> load_fixed_map_file(concptr path, time_t mtime)
+{
+    FILE *fp = angband_fopen(path, "r");
+    if (fp == NULL)
+        return nullptr;
+
+    auto file = std::make_shared<fixed_map_file_type>();
+    file->mtime = mtime;
+    char buf[1024];
+    int num = -1;
+    while (angband_fgets(fp, buf, sizeof(buf)) == 0) {
+        num++;
+        if (!buf[0] || iswspace(buf[0]) || buf[0] == '#')
+            continue;
+
+        file->lines.push_back({ num, (buf[0] == '?') && (buf[1] == ':'), 0, buf });
+    }
+
+    angband_fclose(fp);
+    size_t next_condition = file->lines.size();
+    for (auto it = file->lines.rbegin(); it != file->lines.rend(); it++) {
+        it->next_condition = next_condition;
+        if (it->is_condition)
+            next_condition = std::distance(it, file->lines.rend()) - 1;
+    }
+
+    return file;
+}
+
+/*!
+ * @brief 固定マップファイルを読み込み済みの内容から返す
+ * @param name ファイル名
+ * @return 読み込んだファイル。開けなければnullptr
+ * @details
+ * 一度読んだファイルは更新時刻が変わらない限り読み直さない。
+ */
+std::shared_ptr<const fixed_map_file_type> get_fixed_map_file(concptr name)
+{
+    static std::map<std::string, std::shared_ptr<const fixed_map_file_type>> files;
+    char path[1024];
+    path_build(path, sizeof(path), ANGBAND_DIR_EDIT, name);
+    struct stat file_stat;
+    if (stat(path, &file_stat) != 0)
+        return nullptr;
+
+    auto &file = files[name];
+    if (!file || (file->mtime != file_stat.st_mtime))
+        file = load_fixed_map_file(path, file_stat.st_mtime);
+
+    return file;
+}
+}
+
 /*!
  * @brief 固定マップ (クエスト＆街＆広域マップ)をq_info、t_info、w_infoから読み込んでパースする
  * @param player_ptr プレーヤーへの参照ポインタ
@@ -234,39 +320,36 @@ static concptr parse_fixed_map_expression(player_type *player_ptr, char **sp, ch
  */
 parse_error_type parse_fixed_map(player_type *player_ptr, concptr name, int ymin, int xmin, int ymax, int xmax)
 {
-    char buf[1024];
-    path_build(buf, sizeof(buf), ANGBAND_DIR_EDIT, name);
-    FILE *fp = angband_fopen(buf, "r");
-    if (fp == NULL)
+    /* 入れ子になった %: で同じファイルが読み直されても、解釈中の内容は手放さない */
+    auto file = get_fixed_map_file(name);
+    if (!file)
         return PARSE_ERROR_GENERIC;
 
+    char buf[1024];
     int num = -1;
     parse_error_type err = PARSE_ERROR_NONE;
-    bool bypass = false;
     int x = xmin;
     int y = ymin;
     qtwg_type tmp_qg;
     qtwg_type *qg_ptr = initialize_quest_generator_type(&tmp_qg, buf, ymin, xmin, ymax, xmax, &y, &x);
-    while (angband_fgets(fp, buf, sizeof(buf)) == 0) {
-        num++;
-        if (!buf[0] || iswspace(buf[0]) || buf[0] == '#')
-            continue;
-
-        if ((buf[0] == '?') && (buf[1] == ':')) {
+    for (size_t i = 0; i < file->lines.size();) {
+        const auto &line = file->lines[i];
+        num = line.line_num;
+        strcpy(buf, line.text.data());
+        if (line.is_condition) {
             char f;
             char *s;
             s = buf + 2;
             concptr v = parse_fixed_map_expression(player_ptr, &s, &f);
-            bypass = (streq(v, "0") ? true : false);
+            i = streq(v, "0") ? line.next_condition : i + 1;
             continue;
         }
 
-        if (bypass)
-            continue;
-
         err = generate_fixed_map_floor(player_ptr, qg_ptr, parse_fixed_map);
         if (err != PARSE_ERROR_NONE)
             break;
+
+        i++;
     }
 
     if (err != 0) {
@@ -276,6 +359,5 @@ parse_error_type parse_fixed_map(player_type *player_ptr, concptr name, int ymin
         msg_print(NULL);
     }
 
-    angband_fclose(fp);
     return err;
 }
@@ -157,16 +157,19 @@ void combine_pack(player_type *owner_ptr)
         is_first_combination = false;
         combined = false;
 
+        /* 併合で詰められるのは併合元より後ろのスロットだけなので、索引はこの周回の間使える */
+        ObjectStackIndex stack_index(owner_ptr->inventory_list, INVEN_PACK + 1);
         for (int i = INVEN_PACK; i > 0; i--) {
             object_type *o_ptr;
             o_ptr = &owner_ptr->inventory_list[i];
             if (!o_ptr->k_idx)
                 continue;
-            for (int j = 0; j < i; j++) {
+            for (int j : stack_index.find(o_ptr)) {
+                if (j >= i)
+                    break;
+
                 object_type *j_ptr;
                 j_ptr = &owner_ptr->inventory_list[j];
-                if (!j_ptr->k_idx)
-                    continue;
 
                 /*
                  * Get maximum number of the stack if these
@@ -230,6 +233,13 @@ void reorder_pack(player_type *owner_ptr)
     object_type *o_ptr;
     bool flag = false;
 
+    /* 価値は並べ替えの前に一度だけ計算し、アイテムと一緒に動かす */
+    int32_t values[INVEN_PACK];
+    for (i = 0; i < INVEN_PACK; i++) {
+        o_ptr = &owner_ptr->inventory_list[i];
+        values[i] = o_ptr->k_idx ? object_value(owner_ptr, o_ptr) : 0;
+    }
+
     for (i = 0; i < INVEN_PACK; i++) {
         if ((i == INVEN_PACK) && (owner_ptr->inven_cnt == INVEN_PACK))
             break;
@@ -238,9 +248,9 @@ void reorder_pack(player_type *owner_ptr)
         if (!o_ptr->k_idx)
             continue;
 
-        o_value = object_value(owner_ptr, o_ptr);
+        o_value = values[i];
         for (j = 0; j < INVEN_PACK; j++) {
-            if (object_sort_comp(owner_ptr, o_ptr, o_value, &owner_ptr->inventory_list[j]))
+            if (object_sort_comp(owner_ptr, o_ptr, o_value, &owner_ptr->inventory_list[j], values[j]))
                 break;
         }
 
@@ -252,9 +262,11 @@ void reorder_pack(player_type *owner_ptr)
         q_ptr->copy_from(&owner_ptr->inventory_list[i]);
         for (k = i; k > j; k--) {
             (&owner_ptr->inventory_list[k])->copy_from(&owner_ptr->inventory_list[k - 1]);
+            values[k] = values[k - 1];
         }
 
         (&owner_ptr->inventory_list[j])->copy_from(q_ptr);
+        values[j] = o_value;
         owner_ptr->window_flags |= (PW_INVEN);
     }
 
@@ -114,8 +114,7 @@ static void dump_aux_quest(player_type *creature_ptr, FILE *fff)
 
     for (QUEST_IDX i = 1; i < max_q_idx; i++)
         quest_num[i] = i;
-    int dummy;
-    ang_sort(creature_ptr, quest_num, &dummy, max_q_idx, ang_sort_comp_quest_num, ang_sort_swap_quest_num);
+    ang_sort(quest_num, max_q_idx, ang_sort_comp_quest_num);
 
     fputc('\n', fff);
     do_cmd_knowledge_quests_completed(creature_ptr, fff, quest_num);
@@ -282,7 +281,7 @@ static void dump_aux_arena(player_type *creature_ptr, FILE *fff)
  * @brief 撃破モンスターの情報をファイルにダンプする
  * @param fff ファイルポインタ
  */
-static void dump_aux_monsters(player_type *creature_ptr, FILE *fff)
+static void dump_aux_monsters(FILE *fff)
 {
     fprintf(fff, _("\n  [倒したモンスター]\n\n", "\n  [Defeated Monsters]\n\n"));
 
@@ -344,7 +343,7 @@ static void dump_aux_monsters(player_type *creature_ptr, FILE *fff)
 #endif
 
     /* Sort the array by dungeon depth of monsters */
-    ang_sort(creature_ptr, who, &why, uniq_total, ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, uniq_total, [why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     fprintf(fff, _("\n《上位%ld体のユニーク・モンスター》\n", "\n< Unique monsters top %ld >\n"), MIN(uniq_total, 10));
 
     char buf[80];
@@ -573,7 +572,7 @@ void make_character_dump(player_type *creature_ptr, FILE *fff, display_player_pf
     dump_aux_recall(fff);
     dump_aux_quest(creature_ptr, fff);
     dump_aux_arena(creature_ptr, fff);
-    dump_aux_monsters(creature_ptr, fff);
+    dump_aux_monsters(fff);
     dump_aux_virtues(creature_ptr, fff);
     dump_aux_race_history(creature_ptr, fff);
     dump_aux_realm_history(creature_ptr, fff);
@@ -0,0 +1,225 @@
+﻿/*!
+ * @brief ファイルへの追記を別スレッドで行う /
+ * Append text to files on a background writer thread
+ * @date 2026/10/19
+ * @details
+ * ゲームスレッドは書き込み要求をロックフリーの単一生産者・単一消費者キューへ積むだけで戻る。
+ * 書き込みスレッドはファイルを開いたまま保持し、溜まった要求をまとめて書き出す。
+ * セーブ・日記の閲覧/消去・終了の際は flush_async_file_writer() で書き込み完了を待ち、ファイルを閉じる。
+ */
+
+#include "io/async-file-writer.h"
+#include "util/angband-files.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace {
+/*!
+ * @brief 書き込み要求 (キューのノード)
+ */
+struct write_request_type {
+    std::string path;
+    std::string text;
+    std::atomic<write_request_type *> next{ nullptr };
+};
+
+/*!
+ * @brief 書き込みスレッドとそのキュー
+ * @details
+ * キューは番兵ノードを持つ連結リストで、tail はゲームスレッドだけが、head は書き込みスレッドだけが触る。
+ * 両者の受け渡しは next の release/acquire だけで行うため、要求の追加でロックを取ることはない。
+ * mutex は書き込みスレッドを眠らせる/起こすためにだけ使う。
+ */
+class async_file_writer_type {
+public:
+    async_file_writer_type()
+    {
+        this->head = this->tail = new write_request_type();
+    }
+
+    ~async_file_writer_type()
+    {
+        if (this->worker.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(this->wake_mutex);
+                this->stop_requested = true;
+            }
+
+            this->wake_cv.notify_one();
+            this->worker.join();
+        }
+
+        while (this->head != nullptr) {
+            auto *next = this->head->next.load(std::memory_order_acquire);
+            delete this->head;
+            this->head = next;
+        }
+    }
+
+    void push(std::string &&path, std::string &&text)
+    {
+        if (!this->worker.joinable())
+            this->worker = std::thread(&async_file_writer_type::run, this);
+
+        auto *request = new write_request_type();
+        request->path = std::move(path);
+        request->text = std::move(text);
+        this->tail->next.store(request, std::memory_order_release);
+        this->tail = request;
+
+        /* 取りこぼしても書き込みスレッドは定期的に目を覚ますため、ここではロックを取らない */
+        this->wake_cv.notify_one();
+    }
+
+    void flush()
+    {
+        if (!this->worker.joinable())
+            return;
+
+        std::unique_lock<std::mutex> lock(this->wake_mutex);
+        this->flush_requested = true;
+        this->wake_cv.notify_one();
+        this->done_cv.wait(lock, [this] { return !this->flush_requested.load(); });
+    }
+
+    bool pop_error(std::string &path)
+    {
+        if (!this->failed.load(std::memory_order_acquire))
+            return false;
+
+        path = this->failed_path;
+        this->failed.store(false, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr auto IDLE_WAIT = std::chrono::milliseconds(100); //!< 通知を取りこぼした場合に書き込みが遅れる最大時間
+
+    write_request_type *head; //!< 書き出し済みの番兵 (書き込みスレッド専用)
+    write_request_type *tail; //!< 最後に積まれた要求 (ゲームスレッド専用)
+    std::map<std::string, FILE *> files; //!< 開いたままのファイル (書き込みスレッド専用)
+    std::atomic<bool> flush_requested{ false };
+    std::atomic<bool> stop_requested{ false };
+    std::atomic<bool> failed{ false };
+    std::string failed_path;
+    std::thread worker;
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    std::condition_variable done_cv;
+
+    bool has_request() const
+    {
+        return this->head->next.load(std::memory_order_acquire) != nullptr;
+    }
+
+    FILE *get_file(const std::string &path)
+    {
+        auto it = this->files.find(path);
+        if (it != this->files.end())
+            return it->second;
+
+        FILE *fff = angband_fopen(path.data(), "a");
+        if (fff == nullptr) {
+            if (!this->failed.load(std::memory_order_acquire)) {
+                this->failed_path = path;
+                this->failed.store(true, std::memory_order_release);
+            }
+
+            return nullptr;
+        }
+
+        this->files.emplace(path, fff);
+        return fff;
+    }
+
+    bool write_requests()
+    {
+        bool written = false;
+        while (auto *request = this->head->next.load(std::memory_order_acquire)) {
+            FILE *fff = this->get_file(request->path);
+            if (fff != nullptr) {
+                fputs(request->text.data(), fff);
+                written = true;
+            }
+
+            delete this->head;
+            this->head = request;
+        }
+
+        return written;
+    }
+
+    void close_files()
+    {
+        for (auto &[path, fff] : this->files)
+            angband_fclose(fff);
+
+        this->files.clear();
+    }
+
+    void run()
+    {
+        while (true) {
+            bool stopping = this->stop_requested.load();
+            bool flushing = this->flush_requested.load();
+            if (this->write_requests())
+                for (auto &[path, fff] : this->files)
+                    fflush(fff);
+
+            if (flushing || stopping)
+                this->close_files();
+
+            if (stopping)
+                return;
+
+            std::unique_lock<std::mutex> lock(this->wake_mutex);
+            if (flushing) {
+                this->flush_requested = false;
+                this->done_cv.notify_all();
+            }
+
+            this->wake_cv.wait_for(lock, IDLE_WAIT, [this] { return this->has_request() || this->flush_requested.load() || this->stop_requested.load(); });
+        }
+    }
+};
+
+async_file_writer_type async_file_writer;
+}
+
+/*!
+ * @brief ファイルへの追記を書き込みスレッドに依頼する /
+ * Queue text to be appended to a file by the writer thread
+ * @param path 追記先のファイルパス
+ * @param text 追記する文字列
+ */
+void append_file_async(concptr path, std::string &&text)
+{
+    if (text.empty())
+        return;
+
+    async_file_writer.push(path, std::move(text));
+}
+
+/*!
+ * @brief 依頼済みの追記が全て書き出され、ファイルが閉じられるまで待つ /
+ * Wait until every queued append has reached its file and the files are closed
+ */
+void flush_async_file_writer(void)
+{
+    async_file_writer.flush();
+}
+
+/*!
+ * @brief 書き込みスレッドがファイルを開けなかったかを調べる /
+ * Report a file the writer thread failed to open since the last call
+ * @param path 開けなかったファイルパスを返す参照
+ * @return 開けなかったファイルがあればTRUE
+ */
+bool get_async_file_writer_error(std::string &path)
+{
+    return async_file_writer.pop_error(path);
+}
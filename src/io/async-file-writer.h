@@ -0,0 +1,8 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include <string>
+
+void append_file_async(concptr path, std::string &&text);
+void flush_async_file_writer(void);
+bool get_async_file_writer_error(std::string &path);
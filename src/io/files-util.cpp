@@ -23,6 +23,10 @@
 #include "term/screen-processor.h"
 #include "util/angband-files.h"
 #include "view/display-messages.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 concptr ANGBAND_DIR; //!< Path name: The main "lib" directory This variable is not actually used anywhere in the code
 concptr ANGBAND_DIR_APEX; //!< High score files (binary) These files may be portable between platforms
@@ -87,81 +91,141 @@ errr file_character(player_type *creature_ptr, concptr name, display_player_pf d
     return 0;
 }
 
+namespace {
 /*!
- * @brief ファイルからランダムに行を一つ取得する /
- * Get a random line from a file
- * @param file_name ファイル名
- * @param entry 特定条件時のN:タグヘッダID
- * @param output 出力先の文字列参照ポインタ
- * @return エラーコード
+ * @brief get_rnd_line() 用のファイル1つ分の表
  * @details
- * <pre>
- * Based on the monster speech patch by Matt Graham,
- * </pre>
+ * 空行で区切られた行の並びを run とし、N:タグ毎にどの run の何行目から候補が始まるかを持つ。
+ * 候補はタグの次の行から空行までで、途中の N:タグ行とコメント行は含まない。
+ * そのため続けて書かれた N:タグは後ろの候補を共有する。
  */
-errr get_rnd_line(concptr file_name, int entry, char *output)
+struct random_line_table_type {
+    bool loaded = false; //!< ファイルを読めたか否か
+    std::vector<std::vector<std::string>> runs; //!< 空行で区切られた行の並び
+    std::vector<std::pair<int, int>> headers; //!< N:タグ毎の (run番号, 候補の開始行)
+    std::map<int, int> first_number; //!< N:タグの番号毎の最初のタグ位置
+    int first_any = -1; //!< 最初の N:* の位置
+    int first_male = -1; //!< 最初の N:M の位置
+    int first_female = -1; //!< 最初の N:F の位置
+    int first_error = -1; //!< 最初の番号がない N:タグの位置
+    int error_line_num = 0; //!< first_error のファイル上の行番号
+};
+
+/*!
+ * @brief ファイルを読み込んで get_rnd_line() 用の表を作る
+ * @param file_name ファイル名
+ * @param table 表を受け取る参照
+ */
+void load_random_line_table(concptr file_name, random_line_table_type &table)
 {
     char buf[1024];
     path_build(buf, sizeof(buf), ANGBAND_DIR_FILE, file_name);
-    FILE *fp;
-    fp = angband_fopen(buf, "r");
+    FILE *fp = angband_fopen(buf, "r");
     if (!fp)
-        return -1;
+        return;
 
-    int test;
+    auto first = [&table](int &pos) {
+        if (pos < 0)
+            pos = table.headers.size();
+    };
+
+    table.runs.emplace_back();
     int line_num = 0;
-    while (true) {
-        if (angband_fgets(fp, buf, sizeof(buf)) != 0) {
-            angband_fclose(fp);
-            return -1;
+    while (angband_fgets(fp, buf, sizeof(buf)) == 0) {
+        line_num++;
+        if (!buf[0]) {
+            table.runs.emplace_back();
+            continue;
         }
 
-        line_num++;
-        if ((buf[0] != 'N') || (buf[1] != ':'))
+        if (buf[0] == '#')
             continue;
 
+        if ((buf[0] != 'N') || (buf[1] != ':')) {
+            table.runs.back().push_back(buf);
+            continue;
+        }
+
+        int number;
         if (buf[2] == '*') {
-            break;
+            first(table.first_any);
         } else if (buf[2] == 'M') {
-            if (r_info[entry].flags1 & RF1_MALE)
-                break;
+            first(table.first_male);
         } else if (buf[2] == 'F') {
-            if (r_info[entry].flags1 & RF1_FEMALE)
-                break;
-        } else if (sscanf(&(buf[2]), "%d", &test) != EOF) {
-            if (test == entry)
-                break;
-        } else {
-            msg_format("Error in line %d of %s!", line_num, file_name);
-            angband_fclose(fp);
-            return -1;
+            first(table.first_female);
+        } else if (sscanf(&(buf[2]), "%d", &number) == 1) {
+            table.first_number.emplace(number, table.headers.size());
+        } else if (sscanf(&(buf[2]), "%d", &number) == EOF) {
+            if (table.first_error < 0)
+                table.error_line_num = line_num;
+
+            first(table.first_error);
         }
+
+        table.headers.emplace_back(table.runs.size() - 1, table.runs.back().size());
     }
 
-    int counter;
-    for (counter = 0;; counter++) {
-        while (true) {
-            test = angband_fgets(fp, buf, sizeof(buf));
-            if (!test) {
-                /* Ignore lines starting with 'N:' */
-                if ((buf[0] == 'N') && (buf[1] == ':'))
-                    continue;
-
-                if (buf[0] != '#')
-                    break;
-            } else
-                break;
-        }
+    angband_fclose(fp);
+    table.loaded = true;
+}
+}
 
-        if (!buf[0])
-            break;
+/*!
+ * @brief ファイルからランダムに行を一つ取得する /
+ * Get a random line from a file
+ * @param file_name ファイル名
+ * @param entry 特定条件時のN:タグヘッダID
+ * @param output 出力先の文字列参照ポインタ
+ * @return エラーコード
+ * @details
+ * <pre>
+ * Based on the monster speech patch by Matt Graham,
+ * </pre>
+ * ファイルは初めて使う時に一度だけ読み込んで表にしておく。
+ * entry に当てはまる最初の N:タグを探し、その候補から等確率で1行を選ぶ。
+ */
+errr get_rnd_line(concptr file_name, int entry, char *output)
+{
+    static std::map<std::string, random_line_table_type> tables;
+    auto [it, is_new] = tables.try_emplace(file_name);
+    random_line_table_type &table = it->second;
+    if (is_new)
+        load_random_line_table(file_name, table);
+
+    if (!table.loaded)
+        return -1;
 
-        if (one_in_(counter + 1))
-            strcpy(output, buf);
+    int header = -1;
+    auto consider = [&header](int pos) {
+        if ((pos >= 0) && ((header < 0) || (pos < header)))
+            header = pos;
+    };
+
+    consider(table.first_any);
+    if ((table.first_male >= 0) && (r_info[entry].flags1 & RF1_MALE))
+        consider(table.first_male);
+    if ((table.first_female >= 0) && (r_info[entry].flags1 & RF1_FEMALE))
+        consider(table.first_female);
+    auto number_it = table.first_number.find(entry);
+    if (number_it != table.first_number.end())
+        consider(number_it->second);
+
+    if ((table.first_error >= 0) && ((header < 0) || (table.first_error < header))) {
+        msg_format("Error in line %d of %s!", table.error_line_num, file_name);
+        return -1;
     }
 
-    angband_fclose(fp);
-    return counter ? 0 : -1;
+    if (header < 0)
+        return -1;
+
+    auto [run, start] = table.headers[header];
+    const auto &lines = table.runs[run];
+    int num = lines.size() - start;
+    if (num == 0)
+        return -1;
+
+    strcpy(output, lines[start + randint0(num)].data());
+    return 0;
 }
 
 #ifdef JP
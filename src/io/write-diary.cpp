@@ -8,6 +8,7 @@
 #include "dungeon/dungeon.h"
 #include "dungeon/quest.h"
 #include "info-reader/fixed-map-parser.h"
+#include "io/async-file-writer.h"
 #include "io/files-util.h"
 #include "market/arena-info-table.h"
 #include "monster-race/monster-race.h"
@@ -18,6 +19,8 @@
 #include "util/angband-files.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <stdarg.h>
+#include <string>
 
 bool write_level; //!< @todo *抹殺* したい…
 
@@ -47,25 +50,48 @@ concptr get_ordinal_number_suffix(int num)
 
 
 /*!
- * @brief 日記ファイルを開く
- * @param fff ファイルへのポインタ
- * @param disable_diary 日記への追加を無効化する場合TRUE
- * @return ファイルがあったらTRUE、なかったらFALSE
- * @todo files.c に移すことも検討する？
+ * @brief 日記ファイルのパスを得る
+ * @param buf パスを返すバッファ
+ * @param max バッファの長さ
  */
-static bool open_diary_file(FILE **fff, bool *disable_diary)
+static void get_diary_path(char *buf, int max)
 {
 	GAME_TEXT file_name[MAX_NLEN];
 	sprintf(file_name, _("playrecord-%s.txt", "playrec-%s.txt"), savefile_base);
-	char buf[1024];
-	path_build(buf, sizeof(buf), ANGBAND_DIR_USER, file_name);
-	*fff = angband_fopen(buf, "a");
-	if (*fff) return true;
+	path_build(buf, max, ANGBAND_DIR_USER, file_name);
+}
+
+
+/*!
+ * @brief 書き込みスレッドが日記ファイルを開けなかった場合に日記を一時停止する
+ * @param disable_diary 日記への追加を無効化する場合TRUE
+ * @return 日記ファイルを開けていなかったらTRUE
+ */
+static bool check_diary_error(bool *disable_diary)
+{
+	std::string path;
+	if (!get_async_file_writer_error(path)) return false;
 
-	msg_format(_("%s を開くことができませんでした。プレイ記録を一時停止します。", "Failed to open %s. Play-Record is disabled temporarily."), buf);
+	msg_format(_("%s を開くことができませんでした。プレイ記録を一時停止します。", "Failed to open %s. Play-Record is disabled temporarily."), path.data());
 	msg_format(NULL);
 	*disable_diary = true;
-	return false;
+	return true;
+}
+
+
+/*!
+ * @brief 日記へ書式付きで追記する
+ * @param diary 日記へ追記する文字列
+ * @param fmt 書式
+ */
+static void diary_printf(std::string &diary, concptr fmt, ...)
+{
+	char buf[1024];
+	va_list vp;
+	va_start(vp, fmt);
+	(void)vsnprintf(buf, sizeof(buf), fmt, vp);
+	va_end(vp);
+	diary.append(buf);
 }
 
 
@@ -102,61 +128,61 @@ static QUEST_IDX write_floor(player_type *creature_ptr, concptr *note_level, cha
 
 /*!
  * @brief ペットに関する日記を追加する
- * @param fff 日記ファイル
+ * @param diary 日記へ追記する文字列
  * @param num 日記へ追加する内容番号
  * @param note 日記内容のIDに応じた文字列参照ポインタ
  */
-static void write_diary_pet(FILE *fff, int num, concptr note)
+static void write_diary_pet(std::string &diary, int num, concptr note)
 {
 	switch (num)
 	{
 	case RECORD_NAMED_PET_NAME:
-		fprintf(fff, _("%sを旅の友にすることに決めた。\n", "decided to travel together with %s.\n"), note);
+		diary_printf(diary, _("%sを旅の友にすることに決めた。\n", "decided to travel together with %s.\n"), note);
 		break;
 	case RECORD_NAMED_PET_UNNAME:
-		fprintf(fff, _("%sの名前を消した。\n", "unnamed %s.\n"), note);
+		diary_printf(diary, _("%sの名前を消した。\n", "unnamed %s.\n"), note);
 		break;
 	case RECORD_NAMED_PET_DISMISS:
-		fprintf(fff, _("%sを解放した。\n", "dismissed %s.\n"), note);
+		diary_printf(diary, _("%sを解放した。\n", "dismissed %s.\n"), note);
 		break;
 	case RECORD_NAMED_PET_DEATH:
-		fprintf(fff, _("%sが死んでしまった。\n", "%s died.\n"), note);
+		diary_printf(diary, _("%sが死んでしまった。\n", "%s died.\n"), note);
 		break;
 	case RECORD_NAMED_PET_MOVED:
-		fprintf(fff, _("%sをおいて別のマップへ移動した。\n", "moved to another map leaving %s behind.\n"), note);
+		diary_printf(diary, _("%sをおいて別のマップへ移動した。\n", "moved to another map leaving %s behind.\n"), note);
 		break;
 	case RECORD_NAMED_PET_LOST_SIGHT:
-		fprintf(fff, _("%sとはぐれてしまった。\n", "lost sight of %s.\n"), note);
+		diary_printf(diary, _("%sとはぐれてしまった。\n", "lost sight of %s.\n"), note);
 		break;
 	case RECORD_NAMED_PET_DESTROY:
-		fprintf(fff, _("%sが*破壊*によって消え去った。\n", "%s was killed by *destruction*.\n"), note);
+		diary_printf(diary, _("%sが*破壊*によって消え去った。\n", "%s was killed by *destruction*.\n"), note);
 		break;
 	case RECORD_NAMED_PET_EARTHQUAKE:
-		fprintf(fff, _("%sが岩石に押し潰された。\n", "%s was crushed by falling rocks.\n"), note);
+		diary_printf(diary, _("%sが岩石に押し潰された。\n", "%s was crushed by falling rocks.\n"), note);
 		break;
 	case RECORD_NAMED_PET_GENOCIDE:
-		fprintf(fff, _("%sが抹殺によって消え去った。\n", "%s was a victim of genocide.\n"), note);
+		diary_printf(diary, _("%sが抹殺によって消え去った。\n", "%s was a victim of genocide.\n"), note);
 		break;
 	case RECORD_NAMED_PET_WIZ_ZAP:
-		fprintf(fff, _("%sがデバッグコマンドによって消え去った。\n", "%s was removed by debug command.\n"), note);
+		diary_printf(diary, _("%sがデバッグコマンドによって消え去った。\n", "%s was removed by debug command.\n"), note);
 		break;
 	case RECORD_NAMED_PET_TELE_LEVEL:
-		fprintf(fff, _("%sがテレポート・レベルによって消え去った。\n", "%s was lost after teleporting a level.\n"), note);
+		diary_printf(diary, _("%sがテレポート・レベルによって消え去った。\n", "%s was lost after teleporting a level.\n"), note);
 		break;
 	case RECORD_NAMED_PET_BLAST:
-		fprintf(fff, _("%sを爆破した。\n", "blasted %s.\n"), note);
+		diary_printf(diary, _("%sを爆破した。\n", "blasted %s.\n"), note);
 		break;
 	case RECORD_NAMED_PET_HEAL_LEPER:
-		fprintf(fff, _("%sの病気が治り旅から外れた。\n", "%s was healed and left.\n"), note);
+		diary_printf(diary, _("%sの病気が治り旅から外れた。\n", "%s was healed and left.\n"), note);
 		break;
 	case RECORD_NAMED_PET_COMPACT:
-		fprintf(fff, _("%sがモンスター情報圧縮によって消え去った。\n", "%s was lost when the monster list was pruned.\n"), note);
+		diary_printf(diary, _("%sがモンスター情報圧縮によって消え去った。\n", "%s was lost when the monster list was pruned.\n"), note);
 		break;
 	case RECORD_NAMED_PET_LOSE_PARENT:
-		fprintf(fff, _("%sの召喚者が既にいないため消え去った。\n", "%s disappeared because its summoner left.\n"), note);
+		diary_printf(diary, _("%sの召喚者が既にいないため消え去った。\n", "%s disappeared because its summoner left.\n"), note);
 		break;
 	default:
-		fprintf(fff, "\n");
+		diary_printf(diary, "\n");
 		break;
 	}
 }
@@ -177,7 +203,7 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	int day, hour, min;
 	extract_day_hour_min(creature_ptr, &day, &hour, &min);
 
-	if (disable_diary) return -1;
+	if (disable_diary || check_diary_error(&disable_diary)) return -1;
 
 	if (type == DIARY_FIX_QUEST_C ||
 		type == DIARY_FIX_QUEST_F ||
@@ -192,9 +218,7 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 		creature_ptr->current_floor_ptr->inside_quest = old_quest;
 	}
 
-	FILE *fff = NULL;
-	if (!open_diary_file(&fff, &disable_diary)) return -1;
-
+	std::string diary;
 	concptr note_level = "";
     char note_level_buf[40];
 	QUEST_IDX q_idx = write_floor(creature_ptr, &note_level, note_level_buf);
@@ -205,9 +229,9 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	case DIARY_DIALY:
 	{
 		if (day < MAX_DAYS)
-			fprintf(fff, _("%d日目\n", "Day %d\n"), day);
+			diary_printf(diary, _("%d日目\n", "Day %d\n"), day);
 		else
-			fputs(_("*****日目\n", "Day *****\n"), fff);
+			diary.append(_("*****日目\n", "Day *****\n"));
 
 		do_level = false;
 		break;
@@ -216,34 +240,34 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	{
 		if (num)
 		{
-			fprintf(fff, "%s\n", note);
+			diary_printf(diary, "%s\n", note);
 			do_level = false;
 		}
 		else
-			fprintf(fff, " %2d:%02d %20s %s\n", hour, min, note_level, note);
+			diary_printf(diary, " %2d:%02d %20s %s\n", hour, min, note_level, note);
 
 		break;
 	}
 	case DIARY_ART:
 	{
-		fprintf(fff, _(" %2d:%02d %20s %sを発見した。\n", " %2d:%02d %20s discovered %s.\n"), hour, min, note_level, note);
+		diary_printf(diary, _(" %2d:%02d %20s %sを発見した。\n", " %2d:%02d %20s discovered %s.\n"), hour, min, note_level, note);
 		break;
 	}
 	case DIARY_ART_SCROLL:
 	{
-		fprintf(fff, _(" %2d:%02d %20s 巻物によって%sを生成した。\n", " %2d:%02d %20s created %s by scroll.\n"), hour, min, note_level, note);
+		diary_printf(diary, _(" %2d:%02d %20s 巻物によって%sを生成した。\n", " %2d:%02d %20s created %s by scroll.\n"), hour, min, note_level, note);
 		break;
 	}
 	case DIARY_UNIQUE:
 	{
-		fprintf(fff, _(" %2d:%02d %20s %sを倒した。\n", " %2d:%02d %20s defeated %s.\n"), hour, min, note_level, note);
+		diary_printf(diary, _(" %2d:%02d %20s %sを倒した。\n", " %2d:%02d %20s defeated %s.\n"), hour, min, note_level, note);
 		break;
 	}
 	case DIARY_FIX_QUEST_C:
 	{
 		if (quest[num].flags & QUEST_FLAG_SILENT) break;
 
-		fprintf(fff, _(" %2d:%02d %20s クエスト「%s」を達成した。\n",
+		diary_printf(diary, _(" %2d:%02d %20s クエスト「%s」を達成した。\n",
 			" %2d:%02d %20s completed quest '%s'.\n"), hour, min, note_level, quest[num].name);
 		break;
 	}
@@ -251,7 +275,7 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	{
 		if (quest[num].flags & QUEST_FLAG_SILENT) break;
 
-		fprintf(fff, _(" %2d:%02d %20s クエスト「%s」から命からがら逃げ帰った。\n",
+		diary_printf(diary, _(" %2d:%02d %20s クエスト「%s」から命からがら逃げ帰った。\n",
 			" %2d:%02d %20s ran away from quest '%s'.\n"), hour, min, note_level, quest[num].name);
 		break;
 	}
@@ -259,7 +283,7 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	{
 		GAME_TEXT name[MAX_NLEN];
         strcpy(name, r_info[quest[num].r_idx].name.c_str());
-		fprintf(fff, _(" %2d:%02d %20s ランダムクエスト(%s)を達成した。\n",
+		diary_printf(diary, _(" %2d:%02d %20s ランダムクエスト(%s)を達成した。\n",
 			" %2d:%02d %20s completed random quest '%s'\n"), hour, min, note_level, name);
 		break;
 	}
@@ -267,13 +291,13 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	{
 		GAME_TEXT name[MAX_NLEN];
 		strcpy(name, r_info[quest[num].r_idx].name.c_str());
-		fprintf(fff, _(" %2d:%02d %20s ランダムクエスト(%s)から逃げ出した。\n",
+		diary_printf(diary, _(" %2d:%02d %20s ランダムクエスト(%s)から逃げ出した。\n",
 			" %2d:%02d %20s ran away from quest '%s'.\n"), hour, min, note_level, name);
 		break;
 	}
 	case DIARY_MAXDEAPTH:
 	{
-		fprintf(fff, _(" %2d:%02d %20s %sの最深階%d階に到達した。\n",
+		diary_printf(diary, _(" %2d:%02d %20s %sの最深階%d階に到達した。\n",
 			" %2d:%02d %20s reached level %d of %s for the first time.\n"), hour, min, note_level,
 			_(d_info[creature_ptr->dungeon_idx].name.c_str(), num),
 			_(num, d_info[creature_ptr->dungeon_idx].name.c_str()));
@@ -281,7 +305,7 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	}
 	case DIARY_TRUMP:
 	{
-		fprintf(fff, _(" %2d:%02d %20s %s%sの最深階を%d階にセットした。\n",
+		diary_printf(diary, _(" %2d:%02d %20s %s%sの最深階を%d階にセットした。\n",
 			" %2d:%02d %20s reset recall level of %s to %d %s.\n"), hour, min, note_level, note,
 			_(d_info[num].name.c_str(), (int)max_dlv[num]),
 			_((int)max_dlv[num], d_info[num].name.c_str()));
@@ -295,17 +319,17 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 			: !(creature_ptr->current_floor_ptr->dun_level + num)
 			? _("地上", "the surface")
 			: format(_("%d階", "level %d"), creature_ptr->current_floor_ptr->dun_level + num);
-		fprintf(fff, _(" %2d:%02d %20s %sへ%s。\n", " %2d:%02d %20s %s %s.\n"), hour, min, note_level, _(to, note), _(note, to));
+		diary_printf(diary, _(" %2d:%02d %20s %sへ%s。\n", " %2d:%02d %20s %s %s.\n"), hour, min, note_level, _(to, note), _(note, to));
 		break;
 	}
 	case DIARY_RECALL:
 	{
 		if (!num)
-			fprintf(fff, _(" %2d:%02d %20s 帰還を使って%sの%d階へ下りた。\n", " %2d:%02d %20s recalled to dungeon level %d of %s.\n"),
+			diary_printf(diary, _(" %2d:%02d %20s 帰還を使って%sの%d階へ下りた。\n", " %2d:%02d %20s recalled to dungeon level %d of %s.\n"),
 				hour, min, note_level, _(d_info[creature_ptr->dungeon_idx].name.c_str(), (int)max_dlv[creature_ptr->dungeon_idx]),
 				_((int)max_dlv[creature_ptr->dungeon_idx], d_info[creature_ptr->dungeon_idx].name.c_str()));
 		else
-			fprintf(fff, _(" %2d:%02d %20s 帰還を使って地上へと戻った。\n", " %2d:%02d %20s recalled from dungeon to surface.\n"), hour, min, note_level);
+			diary_printf(diary, _(" %2d:%02d %20s 帰還を使って地上へと戻った。\n", " %2d:%02d %20s recalled from dungeon to surface.\n"), hour, min, note_level);
 
 		break;
 	}
@@ -313,24 +337,24 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	{
 		if (quest[num].flags & QUEST_FLAG_SILENT) break;
 
-		fprintf(fff, _(" %2d:%02d %20s クエスト「%s」へと突入した。\n", " %2d:%02d %20s entered the quest '%s'.\n"),
+		diary_printf(diary, _(" %2d:%02d %20s クエスト「%s」へと突入した。\n", " %2d:%02d %20s entered the quest '%s'.\n"),
 			hour, min, note_level, quest[num].name);
 		break;
 	}
 	case DIARY_TELEPORT_LEVEL:
 	{
-		fprintf(fff, _(" %2d:%02d %20s レベル・テレポートで脱出した。\n", " %2d:%02d %20s got out using teleport level.\n"),
+		diary_printf(diary, _(" %2d:%02d %20s レベル・テレポートで脱出した。\n", " %2d:%02d %20s got out using teleport level.\n"),
 			hour, min, note_level);
 		break;
 	}
 	case DIARY_BUY:
 	{
-		fprintf(fff, _(" %2d:%02d %20s %sを購入した。\n", " %2d:%02d %20s bought %s.\n"), hour, min, note_level, note);
+		diary_printf(diary, _(" %2d:%02d %20s %sを購入した。\n", " %2d:%02d %20s bought %s.\n"), hour, min, note_level, note);
 		break;
 	}
 	case DIARY_SELL:
 	{
-		fprintf(fff, _(" %2d:%02d %20s %sを売却した。\n", " %2d:%02d %20s sold %s.\n"), hour, min, note_level, note);
+		diary_printf(diary, _(" %2d:%02d %20s %sを売却した。\n", " %2d:%02d %20s sold %s.\n"), hour, min, note_level, note);
 		break;
 	}
 	case DIARY_ARENA:
@@ -338,17 +362,17 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 		if (num < 0)
 		{
 			int n = -num;
-			fprintf(fff, _(" %2d:%02d %20s 闘技場の%d%s回戦で、%sの前に敗れ去った。\n", " %2d:%02d %20s beaten by %s in the %d%s fight.\n"),
+			diary_printf(diary, _(" %2d:%02d %20s 闘技場の%d%s回戦で、%sの前に敗れ去った。\n", " %2d:%02d %20s beaten by %s in the %d%s fight.\n"),
 				hour, min, note_level, _(n, note), _("", n), _(note, get_ordinal_number_suffix(n)));
 			break;
 		}
 
-		fprintf(fff, _(" %2d:%02d %20s 闘技場の%d%s回戦(%s)に勝利した。\n", " %2d:%02d %20s won the %d%s fight (%s).\n"),
+		diary_printf(diary, _(" %2d:%02d %20s 闘技場の%d%s回戦(%s)に勝利した。\n", " %2d:%02d %20s won the %d%s fight (%s).\n"),
 			hour, min, note_level, num, _("", get_ordinal_number_suffix(num)), note);
 
 		if (num == MAX_ARENA_MONS)
 		{
-			fprintf(fff, _("                 闘技場のすべての敵に勝利し、チャンピオンとなった。\n",
+			diary_printf(diary, _("                 闘技場のすべての敵に勝利し、チャンピオンとなった。\n",
 				"                 won all fights to become a Champion.\n"));
 			do_level = false;
 		}
@@ -357,7 +381,7 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 	}
 	case DIARY_FOUND:
 	{
-		fprintf(fff, _(" %2d:%02d %20s %sを識別した。\n", " %2d:%02d %20s identified %s.\n"), hour, min, note_level, note);
+		diary_printf(diary, _(" %2d:%02d %20s %sを識別した。\n", " %2d:%02d %20s identified %s.\n"), hour, min, note_level, note);
 		break;
 	}
 	case DIARY_WIZ_TELE:
@@ -365,7 +389,7 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
         concptr to = !is_in_dungeon(creature_ptr)
 			? _("地上", "the surface")
 			: format(_("%d階(%s)", "level %d of %s"), creature_ptr->current_floor_ptr->dun_level, d_info[creature_ptr->dungeon_idx].name.c_str());
-		fprintf(fff, _(" %2d:%02d %20s %sへとウィザード・テレポートで移動した。\n",
+		diary_printf(diary, _(" %2d:%02d %20s %sへとウィザード・テレポートで移動した。\n",
 			" %2d:%02d %20s wizard-teleported to %s.\n"), hour, min, note_level, to);
 		break;
 	}
@@ -374,13 +398,13 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 		concptr to = !is_in_dungeon(creature_ptr)
 			? _("地上", "the surface")
 			: format(_("%d階(%s)", "level %d of %s"), creature_ptr->current_floor_ptr->dun_level, d_info[creature_ptr->dungeon_idx].name.c_str());
-		fprintf(fff, _(" %2d:%02d %20s %sへとパターンの力で移動した。\n",
+		diary_printf(diary, _(" %2d:%02d %20s %sへとパターンの力で移動した。\n",
 			" %2d:%02d %20s used Pattern to teleport to %s.\n"), hour, min, note_level, to);
 		break;
 	}
 	case DIARY_LEVELUP:
 	{
-		fprintf(fff, _(" %2d:%02d %20s レベルが%dに上がった。\n", " %2d:%02d %20s reached player level %d.\n"), hour, min, note_level, num);
+		diary_printf(diary, _(" %2d:%02d %20s レベルが%dに上がった。\n", " %2d:%02d %20s reached player level %d.\n"), hour, min, note_level, num);
 		break;
 	}
 	case DIARY_GAMESTART:
@@ -388,26 +412,28 @@ errr exe_write_diary(player_type *creature_ptr, int type, int num, concptr note)
 		time_t ct = time((time_t*)0);
 		do_level = false;
 		if (num)
-			fprintf(fff, "%s %s", note, ctime(&ct));
+			diary_printf(diary, "%s %s", note, ctime(&ct));
 		else
-			fprintf(fff, " %2d:%02d %20s %s %s", hour, min, note_level, note, ctime(&ct));
+			diary_printf(diary, " %2d:%02d %20s %s %s", hour, min, note_level, note, ctime(&ct));
 
 		break;
 	}
 	case DIARY_NAMED_PET:
 	{
-		fprintf(fff, " %2d:%02d %20s ", hour, min, note_level);
-		write_diary_pet(fff, num, note);
+		diary_printf(diary, " %2d:%02d %20s ", hour, min, note_level);
+		write_diary_pet(diary, num, note);
 		break;
 	}
 	case DIARY_WIZARD_LOG:
-		fprintf(fff, "%s\n", note);
+		diary_printf(diary, "%s\n", note);
 		break;
 	default:
 		break;
 	}
 
-	angband_fclose(fff);
+	char buf[1024];
+	get_diary_path(buf, sizeof(buf));
+	append_file_async(buf, std::move(diary));
 	if (do_level) write_level = false;
 
 	return 0;
@@ -0,0 +1,103 @@
+﻿/*!
+ * @brief 知識メニューのグループ毎の候補一覧 /
+ * Per-group member lists for the knowledge menus
+ * @date 2026/10/19
+ * @details
+ * グループに属するか否かと表示順はマスターデータだけで決まるため、初めて使う時に一度だけ作る。
+ * 思い出の有無のようにゲーム中に変わる条件は、呼び出し側がグループの候補だけを見て判定する。
+ */
+
+#include "knowledge/knowledge-group-index.h"
+#include "knowledge/monster-group-table.h"
+#include "knowledge/object-group-table.h"
+#include "monster-race/monster-race.h"
+#include "monster-race/race-flags1.h"
+#include "monster-race/race-flags3.h"
+#include "monster-race/race-flags7.h"
+#include "object/object-kind.h"
+#include "system/monster-race-definition.h"
+#include "util/bit-flags-calculator.h"
+#include "util/sort.h"
+#include "util/string-processor.h"
+
+/*!
+ * @brief モンスター種族が (思い出の有無を問わず) グループに属するかを返す
+ * @param grp_idx グループ種別
+ * @param r_ptr モンスター種族への参照ポインタ
+ * @return 属するならばTRUE
+ */
+static bool is_monster_group_member(IDX grp_idx, monster_race *r_ptr)
+{
+    concptr group_char = monster_group_char[grp_idx];
+    if (group_char == (char *)-1L)
+        return any_bits(r_ptr->flags1, RF1_UNIQUE);
+
+    if (group_char == (char *)-2L)
+        return any_bits(r_ptr->flags7, RF7_RIDING);
+
+    if (group_char == (char *)-3L)
+        return false;
+
+    if (group_char == (char *)-4L)
+        return any_bits(r_ptr->flags3, RF3_AMBERITE);
+
+    return angband_strchr(group_char, r_ptr->d_char) != NULL;
+}
+
+/*!
+ * @brief モンスターのグループに属する種族の一覧を返す /
+ * Return the races in a monster group, sorted by level
+ * @param grp_idx グループ種別 (monster_group_char の添字)
+ * @return ang_sort_comp_monster_level() の順に並べた種族IDの一覧
+ * @details
+ * 賞金首は日によって変わるため、このグループの一覧は常に空である。
+ */
+const std::vector<MONRACE_IDX> &get_monster_group_races(IDX grp_idx)
+{
+    static std::vector<std::vector<MONRACE_IDX>> groups;
+    if (groups.empty()) {
+        for (IDX i = 0; monster_group_text[i] != NULL; i++) {
+            std::vector<MONRACE_IDX> races;
+            for (MONRACE_IDX r_idx = 0; r_idx < max_r_idx; r_idx++) {
+                monster_race *r_ptr = &r_info[r_idx];
+                if (!r_ptr->name.empty() && is_monster_group_member(i, r_ptr))
+                    races.push_back(r_idx);
+            }
+
+            ang_sort(races.data(), races.size(), ang_sort_comp_monster_level);
+            groups.push_back(std::move(races));
+        }
+    }
+
+    return groups[grp_idx];
+}
+
+/*!
+ * @brief アイテムのグループに属するベースアイテムの一覧を返す /
+ * Return the object kinds in an object group
+ * @param grp_idx グループ種別 (object_group_tval の添字)
+ * @return ベースアイテムIDの昇順の一覧
+ */
+const std::vector<KIND_OBJECT_IDX> &get_object_group_kinds(IDX grp_idx)
+{
+    static std::vector<std::vector<KIND_OBJECT_IDX>> groups;
+    if (groups.empty()) {
+        for (IDX i = 0; object_group_text[i] != NULL; i++) {
+            tval_type group_tval = static_cast<tval_type>(object_group_tval[i]);
+            std::vector<KIND_OBJECT_IDX> kinds;
+            for (KIND_OBJECT_IDX k_idx = 0; k_idx < max_k_idx; k_idx++) {
+                object_kind *k_ptr = &k_info[k_idx];
+                if (k_ptr->name.empty())
+                    continue;
+
+                bool is_member = (group_tval == TV_LIFE_BOOK) ? (TV_LIFE_BOOK <= k_ptr->tval) && (k_ptr->tval <= TV_HEX_BOOK) : (k_ptr->tval == group_tval);
+                if (is_member)
+                    kinds.push_back(k_idx);
+            }
+
+            groups.push_back(std::move(kinds));
+        }
+    }
+
+    return groups[grp_idx];
+}
@@ -0,0 +1,7 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include <vector>
+
+const std::vector<MONRACE_IDX> &get_monster_group_races(IDX grp_idx);
+const std::vector<KIND_OBJECT_IDX> &get_object_group_kinds(IDX grp_idx);
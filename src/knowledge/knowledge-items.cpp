@@ -14,6 +14,7 @@
 #include "inventory/inventory-slot-types.h"
 #include "io-dump/dump-util.h"
 #include "io/input-key-acceptor.h"
+#include "knowledge/knowledge-group-index.h"
 #include "knowledge/object-group-table.h"
 #include "object-enchant/special-object-flags.h"
 #include "object-hook/hook-enchant.h"
@@ -96,7 +97,7 @@ void do_cmd_knowledge_artifacts(player_type *player_ptr)
     }
 
     uint16_t why = 3;
-    ang_sort(player_ptr, who, &why, n, ang_sort_art_comp, ang_sort_art_swap);
+    ang_sort(who, n, [why](ARTIFACT_IDX w1, ARTIFACT_IDX w2) { return ang_sort_art_comp(w1, w2, why); });
     for (ARTIFACT_IDX k = 0; k < n; k++) {
         artifact_type *a_ptr = &a_info[who[k]];
         GAME_TEXT base_name[MAX_NLEN];
@@ -132,12 +133,8 @@ void do_cmd_knowledge_artifacts(player_type *player_ptr)
 static KIND_OBJECT_IDX collect_objects(int grp_cur, KIND_OBJECT_IDX object_idx[], BIT_FLAGS8 mode)
 {
     KIND_OBJECT_IDX object_cnt = 0;
-    byte group_tval = object_group_tval[grp_cur];
-    for (KIND_OBJECT_IDX i = 0; i < max_k_idx; i++) {
+    for (KIND_OBJECT_IDX i : get_object_group_kinds(grp_cur)) {
         object_kind *k_ptr = &k_info[i];
-        if (k_ptr->name.empty())
-            continue;
-
         if (!(mode & 0x02)) {
             if (!current_world_ptr->wizard) {
                 if (!k_ptr->flavor)
@@ -153,16 +150,7 @@ static KIND_OBJECT_IDX collect_objects(int grp_cur, KIND_OBJECT_IDX object_idx[]
                 continue;
         }
 
-        if (TV_LIFE_BOOK == group_tval) {
-            if (TV_LIFE_BOOK <= k_ptr->tval && k_ptr->tval <= TV_HEX_BOOK) {
-                object_idx[object_cnt++] = i;
-            } else
-                continue;
-        } else if (k_ptr->tval == group_tval) {
-            object_idx[object_cnt++] = i;
-        } else
-            continue;
-
+        object_idx[object_cnt++] = i;
         if (mode & 0x01)
             break;
     }
@@ -13,6 +13,7 @@
 #include "game-option/special-options.h"
 #include "io-dump/dump-util.h"
 #include "io/input-key-acceptor.h"
+#include "knowledge/knowledge-group-index.h"
 #include "knowledge/monster-group-table.h"
 #include "locale/english.h"
 #include "lore/lore-util.h"
@@ -40,6 +41,8 @@
 #include "view/display-lore.h"
 #include "view/display-monster-status.h"
 #include "world/world.h"
+#include <algorithm>
+#include <vector>
 
 /*!
  * @brief 特定の与えられた条件に応じてモンスターのIDリストを作成する / Build a list of monster indexes in the given group.
@@ -51,47 +54,29 @@
  */
 static IDX collect_monsters(player_type *creature_ptr, IDX grp_cur, IDX mon_idx[], monster_lore_mode mode)
 {
-    concptr group_char = monster_group_char[grp_cur];
-    bool grp_unique = (monster_group_char[grp_cur] == (char *)-1L);
-    bool grp_riding = (monster_group_char[grp_cur] == (char *)-2L);
-    bool grp_wanted = (monster_group_char[grp_cur] == (char *)-3L);
-    bool grp_amberite = (monster_group_char[grp_cur] == (char *)-4L);
+    std::vector<MONRACE_IDX> wanted_races;
+    const std::vector<MONRACE_IDX> *races = &get_monster_group_races(grp_cur);
+    if (monster_group_char[grp_cur] == (char *)-3L) {
+        for (int j = 0; j < MAX_BOUNTY; j++) {
+            MONRACE_IDX r_idx = current_world_ptr->bounty_r_idx[j];
+            wanted_races.push_back((r_idx >= 10000) ? r_idx - 10000 : r_idx);
+        }
+
+        wanted_races.push_back(creature_ptr->today_mon);
+        wanted_races.erase(std::remove_if(wanted_races.begin(), wanted_races.end(),
+                               [](MONRACE_IDX r_idx) { return (r_idx <= 0) || (r_idx >= max_r_idx) || r_info[r_idx].name.empty(); }),
+            wanted_races.end());
+        ang_sort(wanted_races.data(), wanted_races.size(), ang_sort_comp_monster_level);
+        wanted_races.erase(std::unique(wanted_races.begin(), wanted_races.end()), wanted_races.end());
+        races = &wanted_races;
+    }
 
     IDX mon_cnt = 0;
-    for (IDX i = 0; i < max_r_idx; i++) {
-        monster_race *r_ptr = &r_info[i];
-        if (r_ptr->name.empty())
+    for (MONRACE_IDX r_idx : *races) {
+        if (((mode != MONSTER_LORE_DEBUG) && (mode != MONSTER_LORE_RESEARCH)) && !cheat_know && !r_info[r_idx].r_sights)
             continue;
-        if (((mode != MONSTER_LORE_DEBUG) && (mode != MONSTER_LORE_RESEARCH)) && !cheat_know && !r_ptr->r_sights)
-            continue;
-
-        if (grp_unique) {
-            if (none_bits(r_ptr->flags1, RF1_UNIQUE))
-                continue;
-        } else if (grp_riding) {
-            if (none_bits(r_ptr->flags7, RF7_RIDING))
-                continue;
-        } else if (grp_wanted) {
-            bool wanted = false;
-            for (int j = 0; j < MAX_BOUNTY; j++) {
-                if (current_world_ptr->bounty_r_idx[j] == i || current_world_ptr->bounty_r_idx[j] - 10000 == i
-                    || (creature_ptr->today_mon && creature_ptr->today_mon == i)) {
-                    wanted = true;
-                    break;
-                }
-            }
-
-            if (!wanted)
-                continue;
-        } else if (grp_amberite) {
-            if (none_bits(r_ptr->flags3, RF3_AMBERITE))
-                continue;
-        } else {
-            if (!angband_strchr(group_char, r_ptr->d_char))
-                continue;
-        }
 
-        mon_idx[mon_cnt++] = i;
+        mon_idx[mon_cnt++] = r_idx;
         if (mode == MONSTER_LORE_NORMAL)
             break;
         if (mode == MONSTER_LORE_DEBUG)
@@ -99,8 +84,6 @@ static IDX collect_monsters(player_type *creature_ptr, IDX grp_cur, IDX mon_idx[
     }
 
     mon_idx[mon_cnt] = -1;
-    int dummy_why;
-    ang_sort(creature_ptr, mon_idx, &dummy_why, mon_cnt, ang_sort_comp_monster_level, ang_sort_swap_hook);
     return mon_cnt;
 }
 
@@ -197,7 +180,7 @@ void do_cmd_knowledge_kill_count(player_type *creature_ptr)
 
     uint16_t why = 2;
     char buf[80];
-    ang_sort(creature_ptr, who, &why, n, ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, n, [why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     for (int k = 0; k < n; k++) {
         monster_race *r_ptr = &r_info[who[k]];
         if (any_bits(r_ptr->flags1, RF1_UNIQUE)) {
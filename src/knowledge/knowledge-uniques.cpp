@@ -8,6 +8,7 @@
 #include "game-option/cheat-options.h"
 #include "io-dump/dump-util.h"
 #include "knowledge-items.h"
+#include "knowledge/knowledge-group-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
 #include "system/monster-race-definition.h"
@@ -139,7 +140,8 @@ void do_cmd_knowledge_uniques(player_type *creature_ptr, bool is_alive)
         return;
 
     C_MAKE(unique_list_ptr->who, max_r_idx, MONRACE_IDX);
-    for (IDX i = 1; i < max_r_idx; i++) {
+    /* monster_group_char の先頭はユニークのグループ */
+    for (MONRACE_IDX i : get_monster_group_races(0)) {
         monster_race *r_ptr = &r_info[i];
         if (!sweep_uniques(r_ptr, unique_list_ptr->is_alive))
             continue;
@@ -158,7 +160,7 @@ void do_cmd_knowledge_uniques(player_type *creature_ptr, bool is_alive)
         unique_list_ptr->who[unique_list_ptr->n++] = i;
     }
 
-    ang_sort(creature_ptr, unique_list_ptr->who, &unique_list_ptr->why, unique_list_ptr->n, ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(unique_list_ptr->who, unique_list_ptr->n, [why = unique_list_ptr->why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     display_uniques(unique_list_ptr, fff);
     C_KILL(unique_list_ptr->who, max_r_idx, int16_t);
     angband_fclose(fff);
@@ -13,6 +13,7 @@
 #include "load/load-v1-5-0.h"
 #include "load/monster-loader.h"
 #include "load/old-feature-types.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster/monster-info.h"
 #include "monster/monster-list.h"
@@ -204,7 +205,6 @@ errr rd_saved_floor(player_type *player_ptr, saved_floor_type *sf_ptr)
         return 161;
 
     for (int i = 1; i < limit; i++) {
-        grid_type *g_ptr;
         MONSTER_IDX m_idx;
         monster_type *m_ptr;
         m_idx = m_pop(floor_ptr);
@@ -213,8 +213,7 @@ errr rd_saved_floor(player_type *player_ptr, saved_floor_type *sf_ptr)
 
         m_ptr = &floor_ptr->m_list[m_idx];
         rd_monster(player_ptr, m_ptr);
-        g_ptr = &floor_ptr->grid_array[m_ptr->fy][m_ptr->fx];
-        g_ptr->m_idx = m_idx;
+        set_grid_monster(floor_ptr, m_ptr->fy, m_ptr->fx, m_idx);
         real_r_ptr(m_ptr)->cur_num++;
     }
 
@@ -48,6 +48,7 @@ void rd_version_info(void)
 
 /*!
  * @brief 乱数状態を読み込む / Read RNG state (added in 2.8.0)
+ * @details 用途別の乱数の状態を持たない古いセーブファイルでは、読み込んだ乱数状態から作り直す。
  */
 void rd_randomizer(void)
 {
@@ -56,6 +57,17 @@ void rd_randomizer(void)
     rd_u16b(&Rand_place);
     for (int i = 0; i < RAND_DEG; i++)
         rd_u32b(&Rand_state[i]);
+
+    if (loading_savefile_version_is_older_than(7)) {
+        Rand_streams_init();
+        return;
+    }
+
+    for (int i = 0; i < static_cast<int>(RandomStream::MAX); i++) {
+        uint32_t *state = Rand_stream(static_cast<RandomStream>(i));
+        for (int j = 0; j < 4; j++)
+            rd_u32b(&state[j]);
+    }
 }
 
 /*!
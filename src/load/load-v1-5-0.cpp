@@ -20,6 +20,7 @@
 #include "load/old-feature-types.h"
 #include "mind/mind-weaponsmith.h"
 #include "monster-floor/monster-move.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags-resistance.h"
 #include "monster-race/race-flags1.h"
@@ -780,9 +781,7 @@ errr rd_dungeon_old(player_type *player_ptr)
 
         m_ptr = &floor_ptr->m_list[m_idx];
         rd_monster(player_ptr, m_ptr);
-        grid_type *g_ptr;
-        g_ptr = &floor_ptr->grid_array[m_ptr->fy][m_ptr->fx];
-        g_ptr->m_idx = m_idx;
+        set_grid_monster(floor_ptr, m_ptr->fy, m_ptr->fx, m_idx);
         real_r_ptr(m_ptr)->cur_num++;
     }
 
@@ -151,7 +151,7 @@ bool research_mon(player_type *player_ptr)
     char query = 'y';
 
     if (why) {
-        ang_sort(player_ptr, who, &why, n, ang_sort_comp_hook, ang_sort_swap_hook);
+        ang_sort(who, n, [why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     }
 
     if (old_sym == sym && old_i < n)
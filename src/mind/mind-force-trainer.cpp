@@ -11,6 +11,7 @@
 #include "grid/grid.h"
 #include "mind/mind-magic-resistance.h"
 #include "mind/mind-numbers.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-floor/monster-summon.h"
 #include "monster-floor/place-monster-types.h"
 #include "monster-race/monster-race.h"
@@ -222,8 +223,8 @@ bool shock_power(player_type *caster_ptr)
         return true;
 
     msg_format(_("%sを吹き飛ばした！", "You blow %s away!"), m_name);
-    caster_ptr->current_floor_ptr->grid_array[oy][ox].m_idx = 0;
-    caster_ptr->current_floor_ptr->grid_array[ty][tx].m_idx = m_idx;
+    set_grid_monster(caster_ptr->current_floor_ptr, oy, ox, 0);
+    set_grid_monster(caster_ptr->current_floor_ptr, ty, tx, m_idx);
     m_ptr->fy = ty;
     m_ptr->fx = tx;
 
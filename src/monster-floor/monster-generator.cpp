@@ -37,6 +37,9 @@
 #include "view/display-messages.h"
 #include "wizard/wizard-messages.h"
 #include "game-option/cheat-types.h"
+#include <array>
+#include <utility>
+#include <vector>
 
 #define MON_SCAT_MAXD 10 /*!< mon_scatter()関数によるモンスター配置で許される中心からの最大距離 */
 
@@ -54,6 +57,28 @@ static MONSTER_IDX place_monster_idx = 0;
  */
 static MONSTER_IDX place_monster_m_idx = 0;
 
+/*!
+ * @brief 中心からの距離毎のグリッドの相対位置の一覧を返す / Return the offsets of the grids at each distance from a center
+ * @return distance() が d となる相対位置 (y, x) の一覧を d 毎に並べたもの
+ * @details
+ * dist_offsets_y/x は距離9の輪が一部欠けているため、distance() から作り直す。
+ */
+static const std::array<std::vector<std::pair<POSITION, POSITION>>, MON_SCAT_MAXD> &get_scatter_rings(void)
+{
+    static std::array<std::vector<std::pair<POSITION, POSITION>>, MON_SCAT_MAXD> rings;
+    if (rings[0].empty()) {
+        for (POSITION dy = -(MON_SCAT_MAXD - 1); dy <= MON_SCAT_MAXD - 1; dy++) {
+            for (POSITION dx = -(MON_SCAT_MAXD - 1); dx <= MON_SCAT_MAXD - 1; dx++) {
+                POSITION d = distance(0, 0, dy, dx);
+                if (d < MON_SCAT_MAXD)
+                    rings[d].emplace_back(dy, dx);
+            }
+        }
+    }
+
+    return rings;
+}
+
 /*!
  * @brief モンスター1体を目標地点に可能な限り近い位置に生成する / improved version of scatter() for place monster
  * @param player_ptr プレーヤーへの参照ポインタ
@@ -64,27 +89,24 @@ static MONSTER_IDX place_monster_m_idx = 0;
  * @param x 中心生成位置x座標
  * @param max_dist 生成位置の最大半径
  * @return 成功したらtrue
- *
+ * @details
+ * 中心から距離の近い順に輪を調べ、配置できるグリッドが見つかった最初の輪の中から等確率で選ぶ。
  */
 bool mon_scatter(player_type *player_ptr, MONRACE_IDX r_idx, POSITION *yp, POSITION *xp, POSITION y, POSITION x, POSITION max_dist)
 {
-    POSITION place_x[MON_SCAT_MAXD];
-    POSITION place_y[MON_SCAT_MAXD];
-    int num[MON_SCAT_MAXD];
-
     if (max_dist >= MON_SCAT_MAXD)
         return false;
 
-    int i;
-    for (i = 0; i < MON_SCAT_MAXD; i++)
-        num[i] = 0;
-
     floor_type *floor_ptr = player_ptr->current_floor_ptr;
-    for (POSITION nx = x - max_dist; nx <= x + max_dist; nx++) {
-        for (POSITION ny = y - max_dist; ny <= y + max_dist; ny++) {
+    const auto &rings = get_scatter_rings();
+    for (POSITION d = 0; d <= max_dist; d++) {
+        int num = 0;
+        for (const auto &[dy, dx] : rings[d]) {
+            POSITION ny = y + dy;
+            POSITION nx = x + dx;
             if (!in_bounds(floor_ptr, ny, nx))
                 continue;
-            if (!projectable(player_ptr, y, x, ny, nx))
+            if (!projectable_around(player_ptr, y, x, ny, nx))
                 continue;
             if (r_idx > 0) {
                 monster_race *r_ptr = &r_info[r_idx];
@@ -97,28 +119,18 @@ bool mon_scatter(player_type *player_ptr, MONRACE_IDX r_idx, POSITION *yp, POSIT
                     continue;
             }
 
-            i = distance(y, x, ny, nx);
-            if (i > max_dist)
-                continue;
-
-            num[i]++;
-            if (one_in_(num[i])) {
-                place_x[i] = nx;
-                place_y[i] = ny;
+            num++;
+            if (one_in_(num)) {
+                *yp = ny;
+                *xp = nx;
             }
         }
-    }
 
-    i = 0;
-    while (i < MON_SCAT_MAXD && 0 == num[i])
-        i++;
-    if (i >= MON_SCAT_MAXD)
-        return false;
-
-    *xp = place_x[i];
-    *yp = place_y[i];
+        if (num > 0)
+            return true;
+    }
 
-    return true;
+    return false;
 }
 
 /*!
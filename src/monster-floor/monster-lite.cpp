@@ -6,6 +6,7 @@
 #include "grid/feature-flag-types.h"
 #include "grid/grid.h"
 #include "monster-floor/monster-lite-util.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags7.h"
 #include "monster/monster-status.h"
@@ -147,10 +148,12 @@ void update_mon_lite(player_type *subject_ptr)
     if (!current_world_ptr->timewalk_m_idx) {
         monster_type *m_ptr;
         monster_race *r_ptr;
-        for (int i = 1; i < floor_ptr->m_max; i++) {
+        static std::vector<MONSTER_IDX> monsters;
+        get_monsters_in_rect(floor_ptr, subject_ptr->y - dis_lim, subject_ptr->x - dis_lim, subject_ptr->y + dis_lim, subject_ptr->x + dis_lim, monsters);
+        for (auto i : monsters) {
             m_ptr = &floor_ptr->m_list[i];
             r_ptr = &r_info[m_ptr->r_idx];
-            if (!monster_is_valid(m_ptr) || (m_ptr->cdis > dis_lim))
+            if (m_ptr->cdis > dis_lim)
                 continue;
 
             int rad = 0;
@@ -4,6 +4,7 @@
 #include "floor/cave.h"
 #include "floor/floor-object.h"
 #include "grid/grid.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags2.h"
 #include "monster-race/race-flags7.h"
@@ -67,7 +68,7 @@ void delete_monster_idx(player_type *player_ptr, MONSTER_IDX i)
     if (player_ptr->riding == i)
         player_ptr->riding = 0;
 
-    floor_ptr->grid_array[y][x].m_idx = 0;
+    set_grid_monster(floor_ptr, y, x, 0);
     for (auto it = m_ptr->hold_o_idx_list.begin(); it != m_ptr->hold_o_idx_list.end();) {
         const OBJECT_IDX this_o_idx = *it++;
         delete_object_idx(player_ptr, this_o_idx);
@@ -123,7 +124,7 @@ void wipe_monsters_list(player_type *player_ptr)
         if (!monster_is_valid(m_ptr))
             continue;
 
-        floor_ptr->grid_array[m_ptr->fy][m_ptr->fx].m_idx = 0;
+        set_grid_monster(floor_ptr, m_ptr->fy, m_ptr->fx, 0);
         (void)WIPE(m_ptr, monster_type);
     }
 
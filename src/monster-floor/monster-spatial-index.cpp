@@ -0,0 +1,153 @@
+﻿/*!
+ * @brief モンスターの位置索引 / Spatial index of monsters on the floor
+ * @date 2026/10/19
+ * @details
+ * フロアを MONSTER_BLOCK_SIZE 四方の区画に分け、区画ごとにモンスターのいるグリッドの数を数えておく。
+ * 範囲内のモンスターを探す際は、モンスターのいない区画を飛ばして残りの区画のグリッドだけを調べる。
+ * グリッドの m_idx は set_grid_monster() を通して書き換えること。
+ * 区画の数はモンスターの fy/fx ではなく書き換えたグリッドの位置で数えるため、移動の途中でもずれない。
+ */
+
+#include "monster-floor/monster-spatial-index.h"
+#include "floor/geometry.h"
+#include "system/floor-type-definition.h"
+#include "system/grid-type-definition.h"
+#include "system/monster-type-definition.h"
+#include <algorithm>
+#include <cassert>
+
+/*!
+ * @brief グリッドにいるモンスターを設定し、位置索引を更新する / Set the monster on a grid and keep the spatial index up to date
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ * @param y グリッドのY座標
+ * @param x グリッドのX座標
+ * @param m_idx モンスターID (いなくなったなら0)
+ */
+void set_grid_monster(floor_type *floor_ptr, POSITION y, POSITION x, MONSTER_IDX m_idx)
+{
+    grid_type *g_ptr = &floor_ptr->grid_array[y][x];
+    if ((g_ptr->m_idx != 0) != (m_idx != 0)) {
+        MONSTER_NUMBER diff = (m_idx != 0) ? 1 : -1;
+        floor_ptr->mon_block_num[y / MONSTER_BLOCK_SIZE][x / MONSTER_BLOCK_SIZE] += diff;
+        floor_ptr->mon_block_total += diff;
+    }
+
+    g_ptr->m_idx = m_idx;
+}
+
+/*!
+ * @brief グリッドの内容から位置索引を作り直す / Rebuild the spatial index from the grids
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ */
+void rebuild_monster_spatial_index(floor_type *floor_ptr)
+{
+    for (auto &row : floor_ptr->mon_block_num)
+        std::fill(std::begin(row), std::end(row), 0);
+
+    floor_ptr->mon_block_total = 0;
+    for (POSITION y = 0; y < floor_ptr->height; y++) {
+        for (POSITION x = 0; x < floor_ptr->width; x++) {
+            if (floor_ptr->grid_array[y][x].m_idx == 0)
+                continue;
+
+            floor_ptr->mon_block_num[y / MONSTER_BLOCK_SIZE][x / MONSTER_BLOCK_SIZE]++;
+            floor_ptr->mon_block_total++;
+        }
+    }
+}
+
+#ifdef _DEBUG
+/*!
+ * @brief 位置索引の各区画の数がグリッドの内容と一致しているかを返す
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ * @return 全ての区画で一致していればtrue
+ */
+static bool is_monster_spatial_index_valid(floor_type *floor_ptr)
+{
+    for (POSITION by = 0; by * MONSTER_BLOCK_SIZE < floor_ptr->height; by++) {
+        for (POSITION bx = 0; bx * MONSTER_BLOCK_SIZE < floor_ptr->width; bx++) {
+            MONSTER_NUMBER num = 0;
+            POSITION ey = std::min<POSITION>(floor_ptr->height, (by + 1) * MONSTER_BLOCK_SIZE);
+            POSITION ex = std::min<POSITION>(floor_ptr->width, (bx + 1) * MONSTER_BLOCK_SIZE);
+            for (POSITION y = by * MONSTER_BLOCK_SIZE; y < ey; y++) {
+                for (POSITION x = bx * MONSTER_BLOCK_SIZE; x < ex; x++) {
+                    if (floor_ptr->grid_array[y][x].m_idx != 0)
+                        num++;
+                }
+            }
+
+            if (num != floor_ptr->mon_block_num[by][bx])
+                return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+/*!
+ * @brief 矩形内にいるモンスターを列挙する / List monsters inside a rectangle
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ * @param y1 矩形の上端
+ * @param x1 矩形の左端
+ * @param y2 矩形の下端
+ * @param x2 矩形の右端
+ * @param monsters モンスターIDの格納先 (最初に空にする)
+ * @details
+ * 区画ごとに行優先の順で格納する。m_list の順に処理する必要がある呼び出し元は自分で並べ替えること。
+ * 格納先を使い回せば、呼び出しのたびにメモリを確保することはない。
+ */
+void get_monsters_in_rect(floor_type *floor_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2, std::vector<MONSTER_IDX> &monsters)
+{
+    /* 全てのモンスターはグリッドに1体ずつ載っているので、総数がずれていたら索引を作り直す */
+    if (floor_ptr->mon_block_total != floor_ptr->m_cnt)
+        rebuild_monster_spatial_index(floor_ptr);
+
+#ifdef _DEBUG
+    /* デバッグビルドでは区画ごとの数も照合し、set_grid_monster() を通さない書き換えを検出する */
+    assert(is_monster_spatial_index_valid(floor_ptr));
+#endif
+
+    y1 = std::max<POSITION>(y1, 0);
+    x1 = std::max<POSITION>(x1, 0);
+    y2 = std::min<POSITION>(y2, floor_ptr->height - 1);
+    x2 = std::min<POSITION>(x2, floor_ptr->width - 1);
+
+    monsters.clear();
+    for (POSITION by = y1 / MONSTER_BLOCK_SIZE; by <= y2 / MONSTER_BLOCK_SIZE; by++) {
+        for (POSITION bx = x1 / MONSTER_BLOCK_SIZE; bx <= x2 / MONSTER_BLOCK_SIZE; bx++) {
+            if (floor_ptr->mon_block_num[by][bx] == 0)
+                continue;
+
+            POSITION ey = std::min<POSITION>(y2, by * MONSTER_BLOCK_SIZE + MONSTER_BLOCK_SIZE - 1);
+            POSITION ex = std::min<POSITION>(x2, bx * MONSTER_BLOCK_SIZE + MONSTER_BLOCK_SIZE - 1);
+            for (POSITION y = std::max<POSITION>(y1, by * MONSTER_BLOCK_SIZE); y <= ey; y++) {
+                for (POSITION x = std::max<POSITION>(x1, bx * MONSTER_BLOCK_SIZE); x <= ex; x++) {
+                    MONSTER_IDX m_idx = floor_ptr->grid_array[y][x].m_idx;
+                    if (m_idx != 0)
+                        monsters.push_back(m_idx);
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * @brief 指定地点から一定距離内にいるモンスターを列挙する / List monsters within a distance of a grid
+ * @param floor_ptr 現在フロアへの参照ポインタ
+ * @param y 中心のY座標
+ * @param x 中心のX座標
+ * @param range 距離 (distance() による)
+ * @param monsters モンスターIDの格納先 (最初に空にする)
+ * @details get_monsters_in_rect() と同じく区画ごとに行優先の順で格納する。
+ */
+void get_monsters_in_range(floor_type *floor_ptr, POSITION y, POSITION x, POSITION range, std::vector<MONSTER_IDX> &monsters)
+{
+    get_monsters_in_rect(floor_ptr, y - range, x - range, y + range, x + range, monsters);
+    auto is_outside = [floor_ptr, y, x, range](MONSTER_IDX m_idx) {
+        auto *m_ptr = &floor_ptr->m_list[m_idx];
+        return distance(y, x, m_ptr->fy, m_ptr->fx) > range;
+    };
+
+    monsters.erase(std::remove_if(monsters.begin(), monsters.end(), is_outside), monsters.end());
+}
@@ -0,0 +1,10 @@
+﻿#pragma once
+
+#include "system/angband.h"
+#include <vector>
+
+typedef struct floor_type floor_type;
+void set_grid_monster(floor_type *floor_ptr, POSITION y, POSITION x, MONSTER_IDX m_idx);
+void rebuild_monster_spatial_index(floor_type *floor_ptr);
+void get_monsters_in_rect(floor_type *floor_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2, std::vector<MONSTER_IDX> &monsters);
+void get_monsters_in_range(floor_type *floor_ptr, POSITION y, POSITION x, POSITION range, std::vector<MONSTER_IDX> &monsters);
@@ -130,7 +130,9 @@ bool summon_specific(player_type *player_ptr, MONSTER_IDX who, POSITION y1, POSI
     summon_specific_who = who;
     summon_specific_type = type;
     summon_unique_okay = (mode & PM_ALLOW_UNIQUE) != 0;
-    get_mon_num_prep(player_ptr, summon_specific_okay, get_monster_hook2(player_ptr, y, x));
+    MONRACE_IDX summoner_idx = who > 0 ? floor_ptr->m_list[who].r_idx : 0;
+    const auto &candidates = get_summon_candidates(player_ptr, summoner_idx, type, summon_unique_okay);
+    get_mon_num_prep_candidates(player_ptr, candidates, summon_specific_okay, get_monster_hook2(player_ptr, y, x));
 
     DEPTH dlev = get_dungeon_or_wilderness_level(player_ptr);
     MONRACE_IDX r_idx = get_mon_num(player_ptr, 0, (dlev + lev) / 2 + 5, 0);
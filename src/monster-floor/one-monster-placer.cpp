@@ -19,6 +19,7 @@
 #include "grid/grid.h"
 #include "monster-attack/monster-attack-types.h"
 #include "monster-floor/monster-move.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-floor/monster-summon.h"
 #include "monster-floor/place-monster-types.h"
 #include "monster-race/monster-race.h"
@@ -259,7 +260,7 @@ bool place_monster_one(player_type *player_ptr, MONSTER_IDX who, POSITION y, POS
     if (any_bits(r_ptr->flags1, RF1_UNIQUE) || any_bits(r_ptr->flags7, RF7_NAZGUL) || (r_ptr->level < 10))
         reset_bits(mode, PM_KAGE);
 
-    g_ptr->m_idx = m_pop(floor_ptr);
+    set_grid_monster(floor_ptr, y, x, m_pop(floor_ptr));
     hack_m_idx_ii = g_ptr->m_idx;
     if (!g_ptr->m_idx)
         return false;
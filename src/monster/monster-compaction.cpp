@@ -3,6 +3,7 @@
 #include "game-option/play-record-options.h"
 #include "io/write-diary.h"
 #include "monster-floor/monster-remover.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
 #include "monster/monster-describer.h"
@@ -35,9 +36,7 @@ static void compact_monsters_aux(player_type *player_ptr, MONSTER_IDX i1, MONSTE
 
     POSITION y = m_ptr->fy;
     POSITION x = m_ptr->fx;
-    grid_type *g_ptr;
-    g_ptr = &floor_ptr->grid_array[y][x];
-    g_ptr->m_idx = i2;
+    set_grid_monster(floor_ptr, y, x, i2);
 
     for (const auto this_o_idx : m_ptr->hold_o_idx_list) {
         object_type *o_ptr;
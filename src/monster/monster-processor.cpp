@@ -519,6 +519,7 @@ bool process_monster_fear(player_type *target_ptr, turn_flags *turn_flags_ptr, M
  */
 void process_monsters(player_type *target_ptr)
 {
+    RandomStreamScope rand_scope(RandomStream::AI);
     old_race_flags tmp_flags;
     old_race_flags *old_race_flags_ptr = init_old_race_flags(&tmp_flags);
     target_ptr->current_floor_ptr->monster_noise = false;
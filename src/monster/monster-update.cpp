@@ -17,6 +17,7 @@
 #include "game-option/disturbance-options.h"
 #include "grid/grid.h"
 #include "mind/drs-types.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
 #include "monster-race/race-flags2.h"
@@ -72,14 +73,14 @@ bool update_riding_monster(player_type *target_ptr, turn_flags *turn_flags_ptr,
     if (turn_flags_ptr->is_riding_mon)
         return move_player_effect(target_ptr, ny, nx, MPE_DONT_PICKUP);
 
-    target_ptr->current_floor_ptr->grid_array[oy][ox].m_idx = g_ptr->m_idx;
+    set_grid_monster(target_ptr->current_floor_ptr, oy, ox, g_ptr->m_idx);
     if (g_ptr->m_idx) {
         y_ptr->fy = oy;
         y_ptr->fx = ox;
         update_monster(target_ptr, g_ptr->m_idx, true);
     }
 
-    g_ptr->m_idx = m_idx;
+    set_grid_monster(target_ptr->current_floor_ptr, ny, nx, m_idx);
     m_ptr->fy = ny;
     m_ptr->fx = nx;
     update_monster(target_ptr, m_idx, true);
@@ -500,6 +501,9 @@ static bool update_clear_monster(player_type *subject_ptr, um_type *um_ptr)
  */
 void update_monster(player_type *subject_ptr, MONSTER_IDX m_idx, bool full)
 {
+    if (current_world_ptr->is_prefetching_floor)
+        return;
+
     um_type tmp_um;
     um_type *um_ptr = initialize_um_type(subject_ptr, &tmp_um, m_idx, full);
     if (disturb_high) {
@@ -291,12 +291,15 @@ monsterrace_hook_type get_monster_hook2(player_type *player_ptr, POSITION y, POS
  * @param hook1 生成制約関数1 (NULL の場合、制約なし)
  * @param hook2 生成制約関数2 (NULL の場合、制約なし)
  * @param restrict_to_dungeon 現在プレイヤーのいるダンジョンの制約を適用するか
+ * @param candidates 重みを修正する要素の添字の昇順の一覧 (NULL の場合、全要素)
  * @return 常に 0
  *
  * モンスター生成テーブル alloc_race_table の各要素の基本重み prob1 を指定条件
  * に従って変更し、結果を prob2 に書き込む。
+ * candidates に含まれない要素の重みは 0 とする。
  */
-static errr do_get_mon_num_prep(player_type *player_ptr, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon)
+static errr do_get_mon_num_prep(
+    player_type *player_ptr, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2, const bool restrict_to_dungeon, const std::vector<int> *candidates)
 {
     const floor_type *const floor_ptr = player_ptr->current_floor_ptr;
 
@@ -306,9 +309,15 @@ static errr do_get_mon_num_prep(player_type *player_ptr, const monsterrace_hook_
     DEPTH lev_max = 0; // 重みが正の要素のうち最大階
     int prob2_total = 0; // 重みの総和
 
+    if (candidates) {
+        for (int i = 0; i < alloc_race_size; i++)
+            alloc_race_table[i].prob2 = 0;
+    }
+
     // モンスター生成テーブルの各要素について重みを修正する。
-    for (int i = 0; i < alloc_race_size; i++) {
-        alloc_entry *const entry = &alloc_race_table[i];
+    const int num = candidates ? static_cast<int>(candidates->size()) : alloc_race_size;
+    for (int n = 0; n < num; n++) {
+        alloc_entry *const entry = &alloc_race_table[candidates ? (*candidates)[n] : n];
         const monster_race *const r_ptr = &r_info[entry->index];
 
         // 生成を禁止する要素は重み 0 とする。
@@ -394,7 +403,23 @@ static errr do_get_mon_num_prep(player_type *player_ptr, const monsterrace_hook_
  */
 errr get_mon_num_prep(player_type *player_ptr, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2)
 {
-    return do_get_mon_num_prep(player_ptr, hook1, hook2, true);
+    return do_get_mon_num_prep(player_ptr, hook1, hook2, true, NULL);
+}
+
+/*!
+ * @brief モンスター生成テーブルの重み修正(候補限定)
+ * @param player_ptr
+ * @param candidates 生成を許可しうる要素の添字の昇順の一覧
+ * @param hook1 生成制約関数1 (NULL の場合、制約なし)
+ * @param hook2 生成制約関数2 (NULL の場合、制約なし)
+ * @return 常に 0
+ *
+ * get_mon_num_prep() と同じだが、candidates に含まれない要素は制約関数を呼ばずに生成禁止とする。
+ * get_mon_num() を呼ぶ前に get_mon_num_prep 系関数のいずれかを呼ぶこと。
+ */
+errr get_mon_num_prep_candidates(player_type *player_ptr, const std::vector<int> &candidates, const monsterrace_hook_type hook1, const monsterrace_hook_type hook2)
+{
+    return do_get_mon_num_prep(player_ptr, hook1, hook2, true, &candidates);
 }
 
 /*!
@@ -405,5 +430,5 @@ errr get_mon_num_prep(player_type *player_ptr, const monsterrace_hook_type hook1
  */
 errr get_mon_num_prep_bounty(player_type *player_ptr)
 {
-    return do_get_mon_num_prep(player_ptr, NULL, NULL, false);
+    return do_get_mon_num_prep(player_ptr, NULL, NULL, false, NULL);
 }
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "system/angband.h"
+#include <vector>
 
 typedef struct player_type player_type;
 typedef bool (*monsterrace_hook_type)(player_type *, MONRACE_IDX);
@@ -14,4 +15,5 @@ extern summon_type summon_specific_type;
 monsterrace_hook_type get_monster_hook(player_type *player_ptr);
 monsterrace_hook_type get_monster_hook2(player_type *player_ptr, POSITION y, POSITION x);
 errr get_mon_num_prep(player_type *player_ptr, monsterrace_hook_type hook1, monsterrace_hook_type hook2);
+errr get_mon_num_prep_candidates(player_type *player_ptr, const std::vector<int> &candidates, monsterrace_hook_type hook1, monsterrace_hook_type hook2);
 errr get_mon_num_prep_bounty(player_type *player_ptr);
@@ -11,21 +11,28 @@
 #include "monster/monster-util.h"
 #include "player/player-race.h"
 #include "spell/summon-types.h"
+#include "system/alloc-entries.h"
 #include "system/monster-race-definition.h"
 #include "system/player-type-definition.h"
+#include "util/bit-flags-calculator.h"
 #include "util/string-processor.h"
+#include <array>
+#include <map>
+#include <memory>
 
 /*!
- * @brief 指定されたモンスター種族がsummon_specific_typeで指定された召喚条件に合うかどうかを返す
+ * @brief 指定されたモンスター種族が召喚条件に合うかどうかを返す
  * @param player_ptr プレーヤーへの参照ポインタ
+ * @param summoner_idx 召喚主のモンスター種族ID (プレーヤーなら0)
+ * @param r_idx 判定するモンスター種族ID
+ * @param type 召喚種別
  * @return 召喚条件が一致するならtrue
- * @details
  */
-bool check_summon_specific(player_type *player_ptr, MONRACE_IDX summoner_idx, MONRACE_IDX r_idx)
+static bool check_summon_type(player_type *player_ptr, MONRACE_IDX summoner_idx, MONRACE_IDX r_idx, summon_type type)
 {
     monster_race *r_ptr = &r_info[r_idx];
     bool is_match = false;
-    switch (summon_specific_type) {
+    switch (type) {
     case SUMMON_ANT:
         is_match = r_ptr->d_char == 'a';
         break;
@@ -196,3 +203,110 @@ bool check_summon_specific(player_type *player_ptr, MONRACE_IDX summoner_idx, MO
 
     return is_match;
 }
+
+/*!
+ * @brief 指定されたモンスター種族がsummon_specific_typeで指定された召喚条件に合うかどうかを返す
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @return 召喚条件が一致するならtrue
+ * @details
+ */
+bool check_summon_specific(player_type *player_ptr, MONRACE_IDX summoner_idx, MONRACE_IDX r_idx)
+{
+    return check_summon_type(player_ptr, summoner_idx, r_idx, summon_specific_type);
+}
+
+/*!
+ * @brief モンスター種族が召喚種別の候補になりうるかを返す
+ * @param r_idx 判定するモンスター種族ID
+ * @param type 召喚種別 (SUMMON_KIN 以外)
+ * @return 候補になりうるならtrue
+ * @details
+ * 乱数を使う召喚種別は、乱数次第で条件に合いうる種族をすべて候補とする。
+ * カメレオンはダンジョンによっては召喚種別を問わず召喚されるため、常に候補とする。
+ */
+static bool is_summon_candidate(MONRACE_IDX r_idx, summon_type type)
+{
+    monster_race *r_ptr = &r_info[r_idx];
+    if ((type == SUMMON_NONE) || any_bits(r_ptr->flags7, RF7_CHAMELEON))
+        return true;
+
+    switch (type) {
+    case SUMMON_PYRAMID:
+        return (r_ptr->d_char == 'z') || (r_idx == MON_SCARAB);
+    case SUMMON_ANTI_TIGERS:
+        return (angband_strchr("Pdl", r_ptr->d_char) != NULL) || (r_idx == MON_STAR_VAMPIRE) || (r_idx == MON_SWALLOW) || (r_idx == MON_HAWK)
+            || (r_idx == MON_LION) || (r_idx == MON_BUFFALO) || (r_idx == MON_FIGHTER) || (r_idx == MON_GOLDEN_EAGLE) || (r_idx == MON_SHALLOW_PUDDLE)
+            || (r_idx == MON_DEEP_PUDDLE) || (r_idx == MON_SKY_WHALE);
+    default:
+        return check_summon_type(NULL, 0, r_idx, type);
+    }
+}
+
+/*!
+ * @brief 召喚候補の一覧 / Candidate lists of a summon type
+ */
+struct summon_candidate_list {
+    std::vector<int> all; //!< 候補となる alloc_race_table の添字
+    std::vector<int> non_unique; //!< 上記からユニークとナズグルを除いたもの
+};
+
+/*!
+ * @brief 判定関数に合うモンスター種族から召喚候補の一覧を作る
+ * @param is_candidate 種族IDを受け取り、候補ならtrueを返す関数オブジェクト
+ * @return 召喚候補の一覧
+ */
+template <typename Predicate>
+static summon_candidate_list make_summon_candidate_list(Predicate is_candidate)
+{
+    summon_candidate_list list;
+    for (int i = 0; i < alloc_race_size; i++) {
+        alloc_entry *entry = &alloc_race_table[i];
+        if ((entry->prob1 <= 0) || !is_candidate(entry->index))
+            continue;
+
+        list.all.push_back(i);
+        monster_race *r_ptr = &r_info[entry->index];
+        if (none_bits(r_ptr->flags1, RF1_UNIQUE) && none_bits(r_ptr->flags7, RF7_NAZGUL))
+            list.non_unique.push_back(i);
+    }
+
+    return list;
+}
+
+/*!
+ * @brief 召喚種別に合いうるモンスター生成テーブルの添字一覧を返す /
+ * Return the alloc_race_table entries that may match a summon type
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @param summoner_idx 召喚主のモンスター種族ID (プレーヤーなら0)
+ * @param type 召喚種別
+ * @param allow_unique ユニークとナズグルを候補に含めるか
+ * @return alloc_race_table の添字の昇順の一覧
+ * @details
+ * 召喚種別による条件は種族のマスターデータだけで決まるため、種別毎 (同族召喚ならシンボル毎) に初めて使う時に一度だけ作る。
+ * 一覧は候補の上位集合であり、属性や地形、乱数による判定は呼び出し側が召喚の度に行うこと。
+ */
+const std::vector<int> &get_summon_candidates(player_type *player_ptr, MONRACE_IDX summoner_idx, summon_type type, bool allow_unique)
+{
+    static std::map<summon_type, summon_candidate_list> type_lists;
+    static std::array<std::unique_ptr<summon_candidate_list>, 256> kin_lists;
+    const summon_candidate_list *list;
+    if (type == SUMMON_KIN) {
+        SYMBOL_CODE symbol = summoner_idx > 0 ? r_info[summoner_idx].d_char : get_summon_symbol_from_player(player_ptr);
+        auto &kin_list = kin_lists[static_cast<byte>(symbol)];
+        if (!kin_list) {
+            kin_list = std::make_unique<summon_candidate_list>(make_summon_candidate_list([symbol](MONRACE_IDX r_idx) {
+                return (r_info[r_idx].d_char == symbol) || any_bits(r_info[r_idx].flags7, RF7_CHAMELEON);
+            }));
+        }
+
+        list = kin_list.get();
+    } else {
+        auto it = type_lists.find(type);
+        if (it == type_lists.end())
+            it = type_lists.emplace(type, make_summon_candidate_list([type](MONRACE_IDX r_idx) { return is_summon_candidate(r_idx, type); })).first;
+
+        list = &it->second;
+    }
+
+    return allow_unique ? list->all : list->non_unique;
+}
@@ -1,6 +1,9 @@
 ﻿#pragma once
 
 #include "system/angband.h"
+#include <vector>
 
 typedef struct player_type player_type;
+enum summon_type : int;
 bool check_summon_specific(player_type *player_ptr, MONRACE_IDX summoner_idx, MONRACE_IDX r_idx);
+const std::vector<int> &get_summon_candidates(player_type *player_ptr, MONRACE_IDX summoner_idx, summon_type type, bool allow_unique);
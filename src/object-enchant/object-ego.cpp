@@ -4,6 +4,8 @@
  * @author deskull
  * @details Ego-Item indexes (see "lib/edit/e_info.txt")
  */
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "object-enchant/object-ego.h"
@@ -35,22 +37,30 @@ EGO_IDX max_e_idx;
  * @param slot 取得したいエゴの装備部位
  * @param good TRUEならば通常のエゴ、FALSEならば呪いのエゴが選択対象となる。
  * @return 選択されたエゴ情報のID、万一選択できなかった場合は0が返る。
+ * @details e_info はゲーム中に変わらないため、確率テーブルは部位と種別毎に初めて使う時に一度だけ作る。
  */
 byte get_random_ego(byte slot, bool good)
 {
-    ProbabilityTable<EGO_IDX> prob_table;
-    for (EGO_IDX i = 1; i < max_e_idx; i++) {
-        ego_item_type *e_ptr = &e_info[i];
-        if (e_ptr->slot != slot || e_ptr->rarity <= 0)
-            continue;
-
-        bool worthless = e_ptr->rating == 0 || e_ptr->gen_flags.has_any_of({ TRG::CURSED, TRG::HEAVY_CURSE, TRG::PERMA_CURSE });
-
-        if (good != worthless) {
-            prob_table.entry_item(i, (255 / e_ptr->rarity));
+    static std::map<std::pair<byte, bool>, ProbabilityTable<EGO_IDX>> prob_tables;
+    auto it = prob_tables.find({ slot, good });
+    if (it == prob_tables.end()) {
+        ProbabilityTable<EGO_IDX> prob_table;
+        for (EGO_IDX i = 1; i < max_e_idx; i++) {
+            ego_item_type *e_ptr = &e_info[i];
+            if (e_ptr->slot != slot || e_ptr->rarity <= 0)
+                continue;
+
+            bool worthless = e_ptr->rating == 0 || e_ptr->gen_flags.has_any_of({ TRG::CURSED, TRG::HEAVY_CURSE, TRG::PERMA_CURSE });
+
+            if (good != worthless) {
+                prob_table.entry_item(i, (255 / e_ptr->rarity));
+            }
         }
+
+        it = prob_tables.emplace(std::make_pair(slot, good), std::move(prob_table)).first;
     }
 
+    const auto &prob_table = it->second;
     if (!prob_table.empty()) {
         return prob_table.pick_one_at_random();
     }
@@ -2,37 +2,107 @@
 #include "system/floor-type-definition.h"
 #include "system/object-type-definition.h"
 
-#include <algorithm>
+ObjectIndexList::iterator &ObjectIndexList::iterator::operator++() noexcept
+{
+    o_idx_ = o_list_[o_idx_].next_o_idx;
+    return *this;
+}
 
 void ObjectIndexList::add(floor_type *floor_ptr, OBJECT_IDX o_idx, IDX stack_idx)
 {
+    o_list_ = floor_ptr->o_list;
     if (stack_idx <= 0) {
-        stack_idx = o_idx_list_.empty() ? 1 : floor_ptr->o_list[o_idx_list_.front()].stack_idx + 1;
+        stack_idx = empty() ? 1 : o_list_[head_].stack_idx + 1;
     }
 
-    auto it = std::partition_point(
-        o_idx_list_.begin(), o_idx_list_.end(), [floor_ptr, stack_idx](IDX idx) { return floor_ptr->o_list[idx].stack_idx > stack_idx; });
+    OBJECT_IDX next = head_;
+    while ((next != 0) && (o_list_[next].stack_idx > stack_idx))
+        next = o_list_[next].next_o_idx;
+
+    OBJECT_IDX prev = (next != 0) ? o_list_[next].prev_o_idx : tail_;
+    object_type *o_ptr = &o_list_[o_idx];
+    o_ptr->prev_o_idx = prev;
+    o_ptr->next_o_idx = next;
+    if (prev != 0)
+        o_list_[prev].next_o_idx = o_idx;
+    else
+        head_ = o_idx;
+
+    if (next != 0)
+        o_list_[next].prev_o_idx = o_idx;
+    else
+        tail_ = o_idx;
+
+    size_++;
+    o_ptr->stack_idx = stack_idx;
+}
+
+/*!
+ * @brief リストに含まれるアイテムを繋がりから外す
+ * @param o_idx 外すアイテムの要素番号
+ */
+void ObjectIndexList::unlink(OBJECT_IDX o_idx)
+{
+    object_type *o_ptr = &o_list_[o_idx];
+    if (o_ptr->prev_o_idx != 0)
+        o_list_[o_ptr->prev_o_idx].next_o_idx = o_ptr->next_o_idx;
+    else
+        head_ = o_ptr->next_o_idx;
+
+    if (o_ptr->next_o_idx != 0)
+        o_list_[o_ptr->next_o_idx].prev_o_idx = o_ptr->prev_o_idx;
+    else
+        tail_ = o_ptr->prev_o_idx;
 
-    o_idx_list_.insert(it, o_idx);
-    floor_ptr->o_list[o_idx].stack_idx = stack_idx;
+    o_ptr->prev_o_idx = 0;
+    o_ptr->next_o_idx = 0;
+    size_--;
 }
 
 void ObjectIndexList::remove(OBJECT_IDX o_idx)
 {
-    o_idx_list_.remove(o_idx);
+    for (const auto this_o_idx : *this) {
+        if (this_o_idx == o_idx) {
+            unlink(o_idx);
+            return;
+        }
+    }
 }
 
 void ObjectIndexList::rotate(floor_type *floor_ptr)
 {
-    if (o_idx_list_.size() < 2)
+    if (size_ < 2)
         return;
 
-    o_idx_list_.push_back(o_idx_list_.front());
-    o_idx_list_.pop_front();
+    OBJECT_IDX o_idx = head_;
+    unlink(o_idx);
+    o_list_[o_idx].prev_o_idx = tail_;
+    o_list_[tail_].next_o_idx = o_idx;
+    tail_ = o_idx;
+    size_++;
 
-    for (const auto o_idx : o_idx_list_) {
-        floor_ptr->o_list[o_idx].stack_idx++;
+    for (const auto this_o_idx : *this) {
+        floor_ptr->o_list[this_o_idx].stack_idx++;
     }
 
-    floor_ptr->o_list[o_idx_list_.back()].stack_idx = 1;
+    floor_ptr->o_list[tail_].stack_idx = 1;
+}
+
+void ObjectIndexList::replace(OBJECT_IDX old_o_idx, OBJECT_IDX new_o_idx)
+{
+    object_type *o_ptr = &o_list_[old_o_idx];
+    if (o_ptr->prev_o_idx != 0)
+        o_list_[o_ptr->prev_o_idx].next_o_idx = new_o_idx;
+    else
+        head_ = new_o_idx;
+
+    if (o_ptr->next_o_idx != 0)
+        o_list_[o_ptr->next_o_idx].prev_o_idx = new_o_idx;
+    else
+        tail_ = new_o_idx;
+}
+
+void ObjectIndexList::pop_front()
+{
+    unlink(head_);
 }
@@ -2,17 +2,66 @@
 
 #include "system/angband.h"
 
-#include <list>
+#include <cstddef>
+#include <iterator>
 
 struct floor_type;
+typedef struct object_type object_type;
 
 /**
  * @brief アイテムリスト(床上スタック/モンスター所持)を管理するクラス
  *
- * @details object_type 自体を保持するのではなく、フロア全体の object_type 配列上のアイテムの要素番号を保持する
+ * @details object_type 自体を保持するのではなく、フロア全体の object_type 配列上のアイテムの要素番号を保持する。
+ * リストの繋がりは各アイテムの next_o_idx / prev_o_idx に持たせ、このクラスは先頭と末尾の要素番号だけを持つ。
+ * そのためアイテムの出し入れでメモリを確保することはない。
+ * アイテムは同時に1つのリストにしか属さないため、コピーしたリストは元のリストと同じ繋がりを指す。
  */
 class ObjectIndexList {
 public:
+    /**
+     * @brief アイテムリストを先頭から辿るイテレータ
+     *
+     * @details 指しているアイテムをリストから取り除くと次に進めなくなるため、取り除く前に進めておくこと。
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = OBJECT_IDX;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const OBJECT_IDX *;
+        using reference = OBJECT_IDX;
+
+        iterator(const object_type *o_list, OBJECT_IDX o_idx) noexcept
+            : o_list_(o_list)
+            , o_idx_(o_idx)
+        {
+        }
+
+        OBJECT_IDX operator*() const noexcept
+        {
+            return o_idx_;
+        }
+        iterator &operator++() noexcept;
+        iterator operator++(int) noexcept
+        {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+        bool operator==(const iterator &other) const noexcept
+        {
+            return o_idx_ == other.o_idx_;
+        }
+        bool operator!=(const iterator &other) const noexcept
+        {
+            return o_idx_ != other.o_idx_;
+        }
+
+    private:
+        const object_type *o_list_;
+        OBJECT_IDX o_idx_;
+    };
+
     /**
      * @brief デフォルトコンストラクタ
      */
@@ -37,6 +86,7 @@ public:
     /**
      * @brief アイテムリストからフロア全体のアイテム配列上の指定した要素番号のアイテムを削除する
      *
+     * @details アイテムリストに含まれないアイテムを指定した場合は何もしない。
      * @param o_idx 削除するアイテムのフロア全体のアイテム配列上の要素番号
      */
     void remove(OBJECT_IDX o_idx);
@@ -51,46 +101,55 @@ public:
      */
     void rotate(floor_type *floor_ptr);
 
+    /**
+     * @brief アイテムリスト内のアイテムの要素番号を付け替える
+     *
+     * @details アイテム配列を詰める時に、移動元のアイテムがまだ移動元の要素番号にある状態で呼ぶこと。
+     * @param old_o_idx 移動元の要素番号
+     * @param new_o_idx 移動先の要素番号
+     */
+    void replace(OBJECT_IDX old_o_idx, OBJECT_IDX new_o_idx);
+
+    /**
+     * @brief アイテムリストの先頭のアイテムを削除する
+     */
+    void pop_front();
+
     //
-    // 以下のメソッドは内部で保持している std::list オブジェクトに対して使用できる同名のメソッド
+    // 以下のメソッドは std::list に対して使用できる同名のメソッドと同じ振る舞いをする
     //
-    auto empty() const noexcept
+    bool empty() const noexcept
     {
-        return o_idx_list_.empty();
+        return head_ == 0;
     }
-    auto size() const noexcept
+    size_t size() const noexcept
     {
-        return o_idx_list_.size();
+        return size_;
     }
     void clear() noexcept
     {
-        o_idx_list_.clear();
-    }
-    auto &front() noexcept
-    {
-        return o_idx_list_.front();
+        head_ = 0;
+        tail_ = 0;
+        size_ = 0;
     }
-    void pop_front() noexcept
+    OBJECT_IDX front() const noexcept
     {
-        return o_idx_list_.pop_front();
+        return head_;
     }
-    auto begin() noexcept
+    iterator begin() const noexcept
     {
-        return o_idx_list_.begin();
+        return iterator(o_list_, head_);
     }
-    auto end() noexcept
+    iterator end() const noexcept
     {
-        return o_idx_list_.end();
-    }
-    auto begin() const noexcept
-    {
-        return o_idx_list_.begin();
-    }
-    auto end() const noexcept
-    {
-        return o_idx_list_.end();
+        return iterator(o_list_, 0);
     }
 
 private:
-    std::list<OBJECT_IDX> o_idx_list_;
+    void unlink(OBJECT_IDX o_idx);
+
+    object_type *o_list_{}; //!< アイテムが存在するフロアのアイテム配列
+    OBJECT_IDX head_{}; //!< 先頭のアイテムの要素番号 (空なら0)
+    OBJECT_IDX tail_{}; //!< 最後尾のアイテムの要素番号 (空なら0)
+    OBJECT_IDX size_{}; //!< アイテム数
 };
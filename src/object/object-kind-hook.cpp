@@ -9,6 +9,7 @@
 #include "sv-definition/sv-amulet-types.h"
 #include "sv-definition/sv-other-types.h"
 #include "sv-definition/sv-ring-types.h"
+#include <vector>
 
 /*
  * Special "sval" limit -- first "good" magic/prayer book
@@ -180,6 +181,44 @@ bool kind_is_good(KIND_OBJECT_IDX k_idx)
     }
 }
 
+/*!
+ * @brief ベースアイテムの大項目毎の索引 / Index of the object kinds sharing a tval
+ */
+struct kind_tval_index_type {
+    std::vector<KIND_OBJECT_IDX> kinds; //!< 大項目が一致するベースアイテムIDの昇順の一覧
+    std::vector<KIND_OBJECT_IDX> by_sval; //!< 小項目を添字とした、一致する最も若いベースアイテムID (無ければ0)
+};
+
+/*!
+ * @brief ベースアイテムの (大項目, 小項目) 索引を返す
+ * @return 大項目を添字とした索引
+ * @details k_info はゲーム中に変わらないため、初めて使う時に一度だけ作る。
+ */
+static const std::vector<kind_tval_index_type> &get_kind_index(void)
+{
+    static std::vector<kind_tval_index_type> index;
+    if (index.empty()) {
+        for (KIND_OBJECT_IDX k = 1; k < max_k_idx; k++) {
+            object_kind *k_ptr = &k_info[k];
+            if (static_cast<size_t>(k_ptr->tval) >= index.size())
+                index.resize(k_ptr->tval + 1);
+
+            auto &tval_index = index[k_ptr->tval];
+            tval_index.kinds.push_back(k);
+            if (k_ptr->sval < 0)
+                continue;
+
+            if (static_cast<size_t>(k_ptr->sval) >= tval_index.by_sval.size())
+                tval_index.by_sval.resize(k_ptr->sval + 1, 0);
+
+            if (tval_index.by_sval[k_ptr->sval] == 0)
+                tval_index.by_sval[k_ptr->sval] = k;
+        }
+    }
+
+    return index;
+}
+
 /*!
  * @brief tvalとsvalに対応するベースアイテムのIDを返す。
  * Find the index of the object_kind with the given tval and sval
@@ -188,24 +227,27 @@ bool kind_is_good(KIND_OBJECT_IDX k_idx)
  */
 KIND_OBJECT_IDX lookup_kind(tval_type tval, OBJECT_SUBTYPE_VALUE sval)
 {
+    const auto &index = get_kind_index();
+    if ((tval < 0) || (static_cast<size_t>(tval) >= index.size()))
+        return 0;
+
+    const auto &tval_index = index[tval];
+    if (sval != SV_ANY) {
+        if ((sval < 0) || (static_cast<size_t>(sval) >= tval_index.by_sval.size()))
+            return 0;
+
+        return tval_index.by_sval[sval];
+    }
+
     int num = 0;
     KIND_OBJECT_IDX bk = 0;
-    for (KIND_OBJECT_IDX k = 1; k < max_k_idx; k++) {
-        object_kind *k_ptr = &k_info[k];
-        if (k_ptr->tval != tval)
-            continue;
-
-        if (k_ptr->sval == sval)
+    for (KIND_OBJECT_IDX k : tval_index.kinds) {
+        if (k_info[k].sval == SV_ANY)
             return k;
 
-        if ((sval != SV_ANY) || !one_in_(++num))
-            continue;
-
-        bk = k;
+        if (one_in_(++num))
+            bk = k;
     }
 
-    if (sval == SV_ANY)
-        return bk;
-
-    return 0;
+    return bk;
 }
@@ -15,6 +15,7 @@
 #include "perception/object-perception.h"
 #include "sv-definition/sv-other-types.h"
 #include "system/object-type-definition.h"
+#include <algorithm>
 
 /*!
  * @brief 魔法棒やロッドのスロット分割時に使用回数を分配する /
@@ -65,6 +66,59 @@ void reduce_charges(object_type *o_ptr, int amt)
     }
 }
 
+/*!
+ * @brief 重ね合わせの判定に使うキーを返す / Get the stacking key of an object
+ * @param o_ptr キーを求めるオブジェクトの構造体参照ポインタ
+ * @return キー
+ * @details
+ * ベースアイテム、追加フラグ、破損状態のように object_similar_part() が一致を要求し、
+ * かつ object_absorb() で変化しない項目だけから求める。
+ * object_similar_part() が0以外を返す2つのオブジェクトのキーは必ず一致するため、
+ * キーの異なるオブジェクト同士の判定は省いてよい。
+ */
+uint32_t object_stack_key(const object_type *o_ptr)
+{
+    uint32_t key = 2166136261U;
+    auto mix = [&key](uint32_t value) { key = (key ^ value) * 16777619U; };
+    mix(o_ptr->k_idx);
+    for (int i = 0; i < TR_FLAG_SIZE; i++)
+        mix(o_ptr->art_flags[i]);
+
+    mix(o_ptr->ident & IDENT_BROKEN);
+    return key;
+}
+
+/*!
+ * @brief オブジェクトの並びから重ね合わせの索引を作る / Build a stacking index over an array of objects
+ * @param objects オブジェクトの配列
+ * @param num 配列の要素数
+ */
+ObjectStackIndex::ObjectStackIndex(const object_type *objects, int num)
+{
+    for (int i = 0; i < num; i++) {
+        if (objects[i].k_idx)
+            this->entries.emplace_back(object_stack_key(&objects[i]), i);
+    }
+
+    std::sort(this->entries.begin(), this->entries.end());
+}
+
+/*!
+ * @brief 重ね合わせ先の候補となる添字を返す / Get the slots an object may stack with
+ * @param o_ptr 重ね合わせたいオブジェクトの構造体参照ポインタ
+ * @return キーが一致する添字の一覧 (昇順)
+ */
+std::vector<int> ObjectStackIndex::find(const object_type *o_ptr) const
+{
+    uint32_t key = object_stack_key(o_ptr);
+    auto first = std::lower_bound(this->entries.begin(), this->entries.end(), std::make_pair(key, 0));
+    std::vector<int> slots;
+    for (auto it = first; (it != this->entries.end()) && (it->first == key); ++it)
+        slots.push_back(it->second);
+
+    return slots;
+}
+
 /*!
  * @brief 両オブジェクトをスロットに重ね合わせ可能な最大数を返す。
  * Determine if an item can partly absorb a second item. Return maximum number of stack.
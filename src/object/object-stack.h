@@ -1,6 +1,25 @@
 ﻿#pragma once
 
+#include "system/angband.h"
+#include <utility>
+#include <vector>
+
 typedef struct object_type object_type;
+
+/*!
+ * @brief 重ね合わせのキーで引ける、オブジェクト配列の添字の索引 / Index of array slots by stacking key
+ * @details 作成後に配列の並びが変わった場合は作り直すこと。
+ */
+class ObjectStackIndex {
+public:
+    ObjectStackIndex(const object_type *objects, int num);
+    std::vector<int> find(const object_type *o_ptr) const;
+
+private:
+    std::vector<std::pair<uint32_t, int>> entries; //!< キーと添字の組 (昇順)
+};
+
+uint32_t object_stack_key(const object_type *o_ptr);
 void distribute_charges(object_type *o_ptr, object_type *q_ptr, int amt);
 void reduce_charges(object_type *o_ptr, int amt);
 int object_similar_part(object_type *o_ptr, object_type *j_ptr);
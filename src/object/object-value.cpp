@@ -16,6 +16,10 @@
 #include "system/object-type-definition.h"
 #include "system/player-type-definition.h"
 #include "util/bit-flags-calculator.h"
+#include <cstring>
+#ifdef CHECK_OBJECT_VALUE_CACHE
+#include <cassert>
+#endif
 
 /*!
  * @brief 未鑑定なベースアイテムの基本価格を返す /
@@ -137,7 +141,7 @@ PRICE object_value(player_type *player_ptr, object_type *o_ptr)
  *\n
  * Every wearable item with a "pval" bonus is worth extra (see below).\n
  */
-PRICE object_value_real(player_type *player_ptr, object_type *o_ptr)
+static PRICE calc_object_value_real(player_type *player_ptr, object_type *o_ptr)
 {
     TrFlags flgs;
     object_kind *k_ptr = &k_info[o_ptr->k_idx];
@@ -329,3 +333,49 @@ PRICE object_value_real(player_type *player_ptr, object_type *o_ptr)
 
     return (value);
 }
+
+/*!
+ * @brief 本価格の計算に使う数値フィールドを写し取る
+ * @param o_ptr 対象のオブジェクト構造体参照ポインタ
+ * @param fields 写しを受け取る配列
+ * @details
+ * calc_object_value_real() とそこから呼ばれる関数が読むフィールドを全て並べる。
+ * 価格の計算で新たなフィールドを参照するようにした時は、ここにも加えること。
+ */
+static void get_object_value_fields(object_type *o_ptr, decltype(object_value_cache_type::fields) &fields)
+{
+    fields = { o_ptr->k_idx, o_ptr->tval, o_ptr->sval, o_ptr->pval, o_ptr->number, o_ptr->name1, o_ptr->name2, o_ptr->art_name, o_ptr->xtra2,
+        o_ptr->xtra3, o_ptr->xtra4, o_ptr->to_h, o_ptr->to_d, o_ptr->to_a, o_ptr->dd, o_ptr->ds };
+}
+
+/*!
+ * @brief オブジェクトの真の価格を返す (キャッシュ付き) /
+ * Return the real price of an item, reusing the last result while the item is unchanged
+ * @param o_ptr 本価格を確認したいオブジェクトの構造体参照ポインタ
+ * @return オブジェクトの本価格
+ * @details
+ * 本価格はオブジェクト自身のフィールドと固定のマスターデータだけで決まるため、
+ * 前回計算した時点のフィールドの写しと現在の値が一致すれば前回の結果を返す。
+ * アイテムのフィールドは識別・強化・呪い・鍛冶の他にも多くの箇所で直接書き換えられるため、
+ * 書き換える側で無効化するのではなく、読む側で写しと比べて変化を検出する。
+ * CHECK_OBJECT_VALUE_CACHE を定義してビルドすると、キャッシュを使う度に再計算した値と一致するかを検査する。
+ */
+PRICE object_value_real(player_type *player_ptr, object_type *o_ptr)
+{
+    decltype(object_value_cache_type::fields) fields;
+    get_object_value_fields(o_ptr, fields);
+    auto &cache = o_ptr->value_cache;
+    if (cache.valid && (cache.fields == fields) && !std::memcmp(cache.art_flags, o_ptr->art_flags, sizeof(TrFlags)) && (cache.curse_flags == o_ptr->curse_flags)) {
+#ifdef CHECK_OBJECT_VALUE_CACHE
+        assert(cache.value == calc_object_value_real(player_ptr, o_ptr));
+#endif
+        return cache.value;
+    }
+
+    cache.value = calc_object_value_real(player_ptr, o_ptr);
+    cache.fields = fields;
+    std::memcpy(cache.art_flags, o_ptr->art_flags, sizeof(TrFlags));
+    cache.curse_flags = o_ptr->curse_flags;
+    cache.valid = true;
+    return cache.value;
+}
@@ -27,6 +27,7 @@
 #include "inventory/player-inventory.h"
 #include "io/input-key-requester.h"
 #include "mind/mind-ninja.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster/monster-update.h"
 #include "perception/object-perception.h"
 #include "player-status/player-energy.h"
@@ -133,8 +134,8 @@ bool move_player_effect(player_type *creature_ptr, POSITION ny, POSITION nx, BIT
         creature_ptr->y = ny;
         creature_ptr->x = nx;
         if (!(mpe_mode & MPE_DONT_SWAP_MON)) {
-            g_ptr->m_idx = om_idx;
-            oc_ptr->m_idx = nm_idx;
+            set_grid_monster(floor_ptr, ny, nx, om_idx);
+            set_grid_monster(floor_ptr, oy, ox, nm_idx);
             if (om_idx > 0) {
                 monster_type *om_ptr = &floor_ptr->m_list[om_idx];
                 om_ptr->fy = ny;
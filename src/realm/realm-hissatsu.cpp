@@ -22,6 +22,7 @@
 #include "io/input-key-acceptor.h"
 #include "io/input-key-requester.h"
 #include "mind/mind-ninja.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race-hook.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags7.h"
@@ -372,8 +373,8 @@ concptr do_hissatsu_spell(player_type *caster_ptr, SPELL_IDX spell, spell_type m
                 }
                 if ((ty != oy) || (tx != ox)) {
                     msg_format(_("%sを吹き飛ばした！", "You blow %s away!"), m_name);
-                    caster_ptr->current_floor_ptr->grid_array[oy][ox].m_idx = 0;
-                    caster_ptr->current_floor_ptr->grid_array[ty][tx].m_idx = m_idx;
+                    set_grid_monster(caster_ptr->current_floor_ptr, oy, ox, 0);
+                    set_grid_monster(caster_ptr->current_floor_ptr, ty, tx, m_idx);
                     m_ptr->fy = ty;
                     m_ptr->fx = tx;
 
@@ -751,8 +752,8 @@ concptr do_hissatsu_spell(player_type *caster_ptr, SPELL_IDX spell, spell_type m
                     continue;
                 }
 
-                g_ptr->m_idx = 0;
-                caster_ptr->current_floor_ptr->grid_array[ny][nx].m_idx = m_idx;
+                set_grid_monster(caster_ptr->current_floor_ptr, y, x, 0);
+                set_grid_monster(caster_ptr->current_floor_ptr, ny, nx, m_idx);
                 m_ptr->fy = ny;
                 m_ptr->fx = nx;
 
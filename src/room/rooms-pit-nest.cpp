@@ -113,25 +113,18 @@ static concptr pit_subtype_string(int type, bool nest)
 /*
  *! @brief nestのモンスターリストをソートするための関数 /
  *  Comp function for sorting nest monster information
- *  @param u ソート処理対象配列ポインタ
- *  @param v 未使用
- *  @param a 比較対象参照ID1
- *  @param b 比較対象参照ID2
+ *  @param info1 比較対象のモンスター情報1
+ *  @param info2 比較対象のモンスター情報2
  *  TODO: to sort.c
  */
-static bool ang_sort_comp_nest_mon_info(player_type *player_ptr, vptr u, vptr v, int a, int b)
+static bool ang_sort_comp_nest_mon_info(const nest_mon_info_type &info1, const nest_mon_info_type &info2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    nest_mon_info_type *nest_mon_info = (nest_mon_info_type *)u;
-    MONSTER_IDX w1 = nest_mon_info[a].r_idx;
-    MONSTER_IDX w2 = nest_mon_info[b].r_idx;
+    MONSTER_IDX w1 = info1.r_idx;
+    MONSTER_IDX w2 = info2.r_idx;
     monster_race *r1_ptr = &r_info[w1];
     monster_race *r2_ptr = &r_info[w2];
-    int z1 = nest_mon_info[a].used;
-    int z2 = nest_mon_info[b].used;
+    int z1 = info1.used;
+    int z2 = info2.used;
 
     if (z1 < z2)
         return false;
@@ -148,28 +141,7 @@ static bool ang_sort_comp_nest_mon_info(player_type *player_ptr, vptr u, vptr v,
     if (r1_ptr->mexp > r2_ptr->mexp)
         return false;
 
-    return w1 <= w2;
-}
-
-/*!
- * @brief nestのモンスターリストをスワップするための関数 /
- * Swap function for sorting nest monster information
- * @param u スワップ処理対象配列ポインタ
- * @param v 未使用
- * @param a スワップ対象参照ID1
- * @param b スワップ対象参照ID2
- * TODO: to sort.c
- */
-static void ang_sort_swap_nest_mon_info(player_type *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    nest_mon_info_type *nest_mon_info = (nest_mon_info_type *)u;
-    nest_mon_info_type holder = nest_mon_info[a];
-    nest_mon_info[a] = nest_mon_info[b];
-    nest_mon_info[b] = holder;
+    return w1 < w2;
 }
 
 /*!
@@ -370,7 +342,7 @@ bool build_type5(player_type *player_ptr, dun_data_type *dd_ptr)
     }
 
     if (cheat_room) {
-        ang_sort(player_ptr, nest_mon_info, NULL, NUM_NEST_MON_TYPE, ang_sort_comp_nest_mon_info, ang_sort_swap_nest_mon_info);
+        ang_sort(nest_mon_info, NUM_NEST_MON_TYPE, ang_sort_comp_nest_mon_info);
 
         /* Dump the entries (prevent multi-printing) */
         for (i = 0; i < NUM_NEST_MON_TYPE; i++) {
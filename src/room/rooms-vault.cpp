@@ -35,6 +35,10 @@
 #include "system/grid-type-definition.h"
 #include "system/player-type-definition.h"
 #include "wizard/wizard-messages.h"
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
 
 /*
  * The vault generation arrays
@@ -304,301 +308,385 @@ static void coord_trans(POSITION *x, POSITION *y, POSITION xoffset, POSITION yof
     *y += yoffset;
 }
 
+namespace {
+/*!
+ * @brief 変換済みVault雛形の1マスの位置 / Position of a vault cell relative to the vault center
+ */
+struct vault_cell_pos_type {
+    POSITION y; //!< 中心からのY方向のずれ
+    POSITION x; //!< 中心からのX方向のずれ
+};
+
+/*!
+ * @brief 回転・反転を1通り適用したVault雛形 / A vault template with one of the eight transforms applied
+ */
+struct vault_transform_type {
+    POSITION ysize{}; //!< 変換後の縦幅 (find_space() に渡す大きさ)
+    POSITION xsize{}; //!< 変換後の横幅 (find_space() に渡す大きさ)
+    std::vector<vault_cell_pos_type> cells; //!< vault_template_type::glyphs と同じ順に並べた各マスの位置
+};
+
+/*!
+ * @brief 事前に展開したVault雛形 / Precompiled vault template
+ * @details
+ * 空白以外のマスを v_info.txt の走査順に並べ、8通りの回転・反転それぞれの位置を展開しておく。
+ * 配置時の地形・アイテム・モンスターの生成順は元の文字列を走査した場合と同じになる。
+ */
+struct vault_template_type {
+    std::vector<char> glyphs; //!< 空白以外のマスの文字
+    std::vector<int> spawns; //!< モンスターを配置するマスの glyphs 上の添字
+    std::array<vault_transform_type, 8> transforms; //!< 変換ID毎の展開結果
+};
+}
+
+/*!
+ * @brief Vault雛形を作る / Compile a vault record into a template
+ * @param v_ptr Vault情報への参照ポインタ
+ * @return Vault雛形
+ */
+static std::unique_ptr<vault_template_type> compile_vault_template(const vault_type *v_ptr)
+{
+    auto vault = std::make_unique<vault_template_type>();
+    const POSITION ymax = v_ptr->hgt;
+    const POSITION xmax = v_ptr->wid;
+    std::array<POSITION, 8> xoffsets;
+    std::array<POSITION, 8> yoffsets;
+    for (int transno = 0; transno < 8; transno++) {
+        POSITION x = xmax;
+        POSITION y = ymax;
+        coord_trans(&x, &y, 0, 0, transno);
+        xoffsets[transno] = (x < 0) ? -x - 1 : 0;
+        yoffsets[transno] = (y < 0) ? -y - 1 : 0;
+        vault->transforms[transno].xsize = abs(x);
+        vault->transforms[transno].ysize = abs(y);
+    }
+
+    size_t t = 0;
+    for (POSITION dy = 0; dy < ymax; dy++) {
+        for (POSITION dx = 0; dx < xmax; dx++, t++) {
+            const char glyph = (t < v_ptr->text.size()) ? v_ptr->text[t] : '\0';
+            if (glyph == ' ')
+                continue;
+
+            switch (glyph) {
+            case '&':
+            case '@':
+            case '9':
+            case '8':
+            case ',':
+                vault->spawns.push_back(static_cast<int>(vault->glyphs.size()));
+                break;
+            }
+
+            vault->glyphs.push_back(glyph);
+            for (int transno = 0; transno < 8; transno++) {
+                POSITION i = dx;
+                POSITION j = dy;
+                coord_trans(&i, &j, xoffsets[transno], yoffsets[transno], transno);
+
+                /* swap of x/y on 90 or 270 degree rotation */
+                auto &cells = vault->transforms[transno].cells;
+                if (transno % 2 == 0)
+                    cells.push_back({ j - (ymax / 2), i - (xmax / 2) });
+                else
+                    cells.push_back({ j - (xmax / 2), i - (ymax / 2) });
+            }
+        }
+    }
+
+    return vault;
+}
+
+/*!
+ * @brief Vault雛形を返す / Return the template of a vault, compiling it on first use
+ * @param v_idx Vault ID
+ * @return Vault雛形
+ */
+static const vault_template_type &get_vault_template(int v_idx)
+{
+    static std::vector<std::unique_ptr<vault_template_type>> templates;
+    if (templates.empty())
+        templates.resize(max_v_idx);
+
+    auto &vault = templates[v_idx];
+    if (!vault)
+        vault = compile_vault_template(&v_info[v_idx]);
+
+    return *vault;
+}
+
+/*!
+ * @brief 指定した種別のVaultをランダムに1つ選ぶ / Pick a random vault of the given type
+ * @param typ Vault種別 (v_info.txt の X: 行の type)
+ * @return Vault ID。該当するVaultがなければ -1
+ * @details 種別毎のVault IDの一覧は初めて使う時に一度だけ作る。
+ */
+static int pick_vault(byte typ)
+{
+    static std::map<byte, std::vector<int>> vaults_by_type;
+    static bool is_indexed = false;
+    if (!is_indexed) {
+        for (int v_idx = 0; v_idx < max_v_idx; v_idx++)
+            vaults_by_type[v_info[v_idx].typ].push_back(v_idx);
+
+        is_indexed = true;
+    }
+
+    auto it = vaults_by_type.find(typ);
+    if (it == vaults_by_type.end())
+        return -1;
+
+    return it->second[randint0(it->second.size())];
+}
+
 /*!
  * @brief Vaultをフロアに配置する / Hack -- fill in "vault" rooms
  * @param player_ptr プレーヤーへの参照ポインタ
  * @param yval 生成基準Y座標
  * @param xval 生成基準X座標
- * @param ymax VaultのYサイズ
- * @param xmax VaultのXサイズ
- * @param data Vaultのデータ文字列
- * @param xoffset 変換基準X座標
- * @param yoffset 変換基準Y座標
+ * @param vault Vault雛形
  * @param transno 変換ID
  */
-static void build_vault(
-    player_type *player_ptr, POSITION yval, POSITION xval, POSITION ymax, POSITION xmax, concptr data, POSITION xoffset, POSITION yoffset, int transno)
+static void build_vault(player_type *player_ptr, POSITION yval, POSITION xval, const vault_template_type &vault, int transno)
 {
-    POSITION dx, dy, x, y, i, j;
-    concptr t;
-    grid_type *g_ptr;
+    const auto &cells = vault.transforms[transno].cells;
 
     /* Place dungeon features and objects */
     floor_type *floor_ptr = player_ptr->current_floor_ptr;
-    for (t = data, dy = 0; dy < ymax; dy++) {
-        for (dx = 0; dx < xmax; dx++, t++) {
-            /* prevent loop counter from being overwritten */
-            i = dx;
-            j = dy;
-
-            /* Flip / rotate */
-            coord_trans(&i, &j, xoffset, yoffset, transno);
-
-            if (transno % 2 == 0) {
-                /* no swap of x/y */
-                x = xval - (xmax / 2) + i;
-                y = yval - (ymax / 2) + j;
-            } else {
-                /* swap of x/y */
-                x = xval - (ymax / 2) + i;
-                y = yval - (xmax / 2) + j;
-            }
-
-            /* Hack -- skip "non-grids" */
-            if (*t == ' ')
-                continue;
-            g_ptr = &floor_ptr->grid_array[y][x];
-
-            /* Lay down a floor */
-            place_grid(player_ptr, g_ptr, GB_FLOOR);
+    for (size_t k = 0; k < vault.glyphs.size(); k++) {
+        const POSITION y = yval + cells[k].y;
+        const POSITION x = xval + cells[k].x;
+        grid_type *g_ptr = &floor_ptr->grid_array[y][x];
 
-            /* Remove any mimic */
-            g_ptr->mimic = 0;
+        /* Lay down a floor */
+        place_grid(player_ptr, g_ptr, GB_FLOOR);
 
-            /* Part of a vault */
-            g_ptr->info |= (CAVE_ROOM | CAVE_ICKY);
+        /* Remove any mimic */
+        g_ptr->mimic = 0;
 
-            /* Analyze the grid */
-            switch (*t) {
-                /* Granite wall (outer) */
-            case '%':
-                place_grid(player_ptr, g_ptr, GB_OUTER_NOPERM);
-                break;
+        /* Part of a vault */
+        g_ptr->info |= (CAVE_ROOM | CAVE_ICKY);
 
-                /* Granite wall (inner) */
-            case '#':
-                place_grid(player_ptr, g_ptr, GB_INNER);
-                break;
+        /* Analyze the grid */
+        switch (vault.glyphs[k]) {
+            /* Granite wall (outer) */
+        case '%':
+            place_grid(player_ptr, g_ptr, GB_OUTER_NOPERM);
+            break;
 
-                /* Glass wall (inner) */
-            case '$':
-                place_grid(player_ptr, g_ptr, GB_INNER);
-                g_ptr->feat = feat_glass_wall;
-                break;
+            /* Granite wall (inner) */
+        case '#':
+            place_grid(player_ptr, g_ptr, GB_INNER);
+            break;
 
-                /* Permanent wall (inner) */
-            case 'X':
-                place_grid(player_ptr, g_ptr, GB_INNER_PERM);
-                break;
+            /* Glass wall (inner) */
+        case '$':
+            place_grid(player_ptr, g_ptr, GB_INNER);
+            g_ptr->feat = feat_glass_wall;
+            break;
 
-                /* Permanent glass wall (inner) */
-            case 'Y':
-                place_grid(player_ptr, g_ptr, GB_INNER_PERM);
-                g_ptr->feat = feat_permanent_glass_wall;
-                break;
+            /* Permanent wall (inner) */
+        case 'X':
+            place_grid(player_ptr, g_ptr, GB_INNER_PERM);
+            break;
 
-                /* Treasure/trap */
-            case '*':
-                if (randint0(100) < 75) {
-                    place_object(player_ptr, y, x, 0L);
-                } else {
-                    place_trap(player_ptr, y, x);
-                }
-                break;
+            /* Permanent glass wall (inner) */
+        case 'Y':
+            place_grid(player_ptr, g_ptr, GB_INNER_PERM);
+            g_ptr->feat = feat_permanent_glass_wall;
+            break;
 
-                /* Treasure */
-            case '[':
+            /* Treasure/trap */
+        case '*':
+            if (randint0(100) < 75) {
                 place_object(player_ptr, y, x, 0L);
-                break;
+            } else {
+                place_trap(player_ptr, y, x);
+            }
+            break;
 
-                /* Tree */
-            case ':':
-                g_ptr->feat = feat_tree;
-                break;
+            /* Treasure */
+        case '[':
+            place_object(player_ptr, y, x, 0L);
+            break;
 
-                /* Secret doors */
-            case '+':
-                place_secret_door(player_ptr, y, x, DOOR_DEFAULT);
-                break;
+            /* Tree */
+        case ':':
+            g_ptr->feat = feat_tree;
+            break;
 
-                /* Secret glass doors */
-            case '-':
-                place_secret_door(player_ptr, y, x, DOOR_GLASS_DOOR);
-                if (is_closed_door(player_ptr, g_ptr->feat))
-                    g_ptr->mimic = feat_glass_wall;
-                break;
+            /* Secret doors */
+        case '+':
+            place_secret_door(player_ptr, y, x, DOOR_DEFAULT);
+            break;
 
-                /* Curtains */
-            case '\'':
-                place_secret_door(player_ptr, y, x, DOOR_CURTAIN);
-                break;
+            /* Secret glass doors */
+        case '-':
+            place_secret_door(player_ptr, y, x, DOOR_GLASS_DOOR);
+            if (is_closed_door(player_ptr, g_ptr->feat))
+                g_ptr->mimic = feat_glass_wall;
+            break;
 
-                /* Trap */
-            case '^':
-                place_trap(player_ptr, y, x);
-                break;
+            /* Curtains */
+        case '\'':
+            place_secret_door(player_ptr, y, x, DOOR_CURTAIN);
+            break;
 
-                /* Black market in a dungeon */
-            case 'S':
-                set_cave_feat(floor_ptr, y, x, feat_black_market);
-                store_init(NO_TOWN, STORE_BLACK);
-                break;
+            /* Trap */
+        case '^':
+            place_trap(player_ptr, y, x);
+            break;
 
-                /* The Pattern */
-            case 'p':
-                set_cave_feat(floor_ptr, y, x, feat_pattern_start);
-                break;
+            /* Black market in a dungeon */
+        case 'S':
+            set_cave_feat(floor_ptr, y, x, feat_black_market);
+            store_init(NO_TOWN, STORE_BLACK);
+            break;
 
-            case 'a':
-                set_cave_feat(floor_ptr, y, x, feat_pattern_1);
-                break;
+            /* The Pattern */
+        case 'p':
+            set_cave_feat(floor_ptr, y, x, feat_pattern_start);
+            break;
 
-            case 'b':
-                set_cave_feat(floor_ptr, y, x, feat_pattern_2);
-                break;
+        case 'a':
+            set_cave_feat(floor_ptr, y, x, feat_pattern_1);
+            break;
 
-            case 'c':
-                set_cave_feat(floor_ptr, y, x, feat_pattern_3);
-                break;
+        case 'b':
+            set_cave_feat(floor_ptr, y, x, feat_pattern_2);
+            break;
 
-            case 'd':
-                set_cave_feat(floor_ptr, y, x, feat_pattern_4);
-                break;
+        case 'c':
+            set_cave_feat(floor_ptr, y, x, feat_pattern_3);
+            break;
 
-            case 'P':
-                set_cave_feat(floor_ptr, y, x, feat_pattern_end);
-                break;
+        case 'd':
+            set_cave_feat(floor_ptr, y, x, feat_pattern_4);
+            break;
 
-            case 'B':
-                set_cave_feat(floor_ptr, y, x, feat_pattern_exit);
-                break;
+        case 'P':
+            set_cave_feat(floor_ptr, y, x, feat_pattern_end);
+            break;
 
-            case 'A':
-                /* Reward for Pattern walk */
-                floor_ptr->object_level = floor_ptr->base_level + 12;
-                place_object(player_ptr, y, x, AM_GOOD | AM_GREAT);
-                floor_ptr->object_level = floor_ptr->base_level;
-                break;
+        case 'B':
+            set_cave_feat(floor_ptr, y, x, feat_pattern_exit);
+            break;
 
-            case '~':
-                set_cave_feat(floor_ptr, y, x, feat_shallow_water);
-                break;
+        case 'A':
+            /* Reward for Pattern walk */
+            floor_ptr->object_level = floor_ptr->base_level + 12;
+            place_object(player_ptr, y, x, AM_GOOD | AM_GREAT);
+            floor_ptr->object_level = floor_ptr->base_level;
+            break;
 
-            case '=':
-                set_cave_feat(floor_ptr, y, x, feat_deep_water);
-                break;
+        case '~':
+            set_cave_feat(floor_ptr, y, x, feat_shallow_water);
+            break;
 
-            case 'v':
-                set_cave_feat(floor_ptr, y, x, feat_shallow_lava);
-                break;
+        case '=':
+            set_cave_feat(floor_ptr, y, x, feat_deep_water);
+            break;
 
-            case 'w':
-                set_cave_feat(floor_ptr, y, x, feat_deep_lava);
-                break;
+        case 'v':
+            set_cave_feat(floor_ptr, y, x, feat_shallow_lava);
+            break;
 
-            case 'f':
-                set_cave_feat(floor_ptr, y, x, feat_shallow_acid_puddle);
-                break;
+        case 'w':
+            set_cave_feat(floor_ptr, y, x, feat_deep_lava);
+            break;
 
-            case 'F':
-                set_cave_feat(floor_ptr, y, x, feat_deep_acid_puddle);
-                break;
+        case 'f':
+            set_cave_feat(floor_ptr, y, x, feat_shallow_acid_puddle);
+            break;
 
-            case 'g':
-                set_cave_feat(floor_ptr, y, x, feat_shallow_poisonous_puddle);
-                break;
+        case 'F':
+            set_cave_feat(floor_ptr, y, x, feat_deep_acid_puddle);
+            break;
 
-            case 'G':
-                set_cave_feat(floor_ptr, y, x, feat_deep_poisonous_puddle);
-                break;
+        case 'g':
+            set_cave_feat(floor_ptr, y, x, feat_shallow_poisonous_puddle);
+            break;
 
-            case 'h':
-                set_cave_feat(floor_ptr, y, x, feat_cold_zone);
-                break;
+        case 'G':
+            set_cave_feat(floor_ptr, y, x, feat_deep_poisonous_puddle);
+            break;
 
-            case 'H':
-                set_cave_feat(floor_ptr, y, x, feat_heavy_cold_zone);
-                break;
+        case 'h':
+            set_cave_feat(floor_ptr, y, x, feat_cold_zone);
+            break;
 
-            case 'i':
-                set_cave_feat(floor_ptr, y, x, feat_electrical_zone);
-                break;
+        case 'H':
+            set_cave_feat(floor_ptr, y, x, feat_heavy_cold_zone);
+            break;
 
-            case 'I':
-                set_cave_feat(floor_ptr, y, x, feat_heavy_electrical_zone);
-                break;
-            }
+        case 'i':
+            set_cave_feat(floor_ptr, y, x, feat_electrical_zone);
+            break;
+
+        case 'I':
+            set_cave_feat(floor_ptr, y, x, feat_heavy_electrical_zone);
+            break;
         }
     }
 
     /* Place dungeon monsters and objects */
-    for (t = data, dy = 0; dy < ymax; dy++) {
-        for (dx = 0; dx < xmax; dx++, t++) {
-            /* prevent loop counter from being overwritten */
-            i = dx;
-            j = dy;
-
-            /* Flip / rotate */
-            coord_trans(&i, &j, xoffset, yoffset, transno);
-
-            if (transno % 2 == 0) {
-                /* no swap of x/y */
-                x = xval - (xmax / 2) + i;
-                y = yval - (ymax / 2) + j;
-            } else {
-                /* swap of x/y */
-                x = xval - (ymax / 2) + i;
-                y = yval - (xmax / 2) + j;
-            }
+    for (int k : vault.spawns) {
+        const POSITION y = yval + cells[k].y;
+        const POSITION x = xval + cells[k].x;
+
+        /* Analyze the symbol */
+        switch (vault.glyphs[k]) {
+        case '&': {
+            floor_ptr->monster_level = floor_ptr->base_level + 5;
+            place_monster(player_ptr, y, x, (PM_ALLOW_SLEEP | PM_ALLOW_GROUP));
+            floor_ptr->monster_level = floor_ptr->base_level;
+            break;
+        }
 
-            /* Hack -- skip "non-grids" */
-            if (*t == ' ')
-                continue;
+        /* Meaner monster */
+        case '@': {
+            floor_ptr->monster_level = floor_ptr->base_level + 11;
+            place_monster(player_ptr, y, x, (PM_ALLOW_SLEEP | PM_ALLOW_GROUP));
+            floor_ptr->monster_level = floor_ptr->base_level;
+            break;
+        }
 
-            /* Analyze the symbol */
-            switch (*t) {
-            case '&': {
-                floor_ptr->monster_level = floor_ptr->base_level + 5;
-                place_monster(player_ptr, y, x, (PM_ALLOW_SLEEP | PM_ALLOW_GROUP));
-                floor_ptr->monster_level = floor_ptr->base_level;
-                break;
-            }
+        /* Meaner monster, plus treasure */
+        case '9': {
+            floor_ptr->monster_level = floor_ptr->base_level + 9;
+            place_monster(player_ptr, y, x, PM_ALLOW_SLEEP);
+            floor_ptr->monster_level = floor_ptr->base_level;
+            floor_ptr->object_level = floor_ptr->base_level + 7;
+            place_object(player_ptr, y, x, AM_GOOD);
+            floor_ptr->object_level = floor_ptr->base_level;
+            break;
+        }
+
+        /* Nasty monster and treasure */
+        case '8': {
+            floor_ptr->monster_level = floor_ptr->base_level + 40;
+            place_monster(player_ptr, y, x, PM_ALLOW_SLEEP);
+            floor_ptr->monster_level = floor_ptr->base_level;
+            floor_ptr->object_level = floor_ptr->base_level + 20;
+            place_object(player_ptr, y, x, AM_GOOD | AM_GREAT);
+            floor_ptr->object_level = floor_ptr->base_level;
+            break;
+        }
 
-            /* Meaner monster */
-            case '@': {
-                floor_ptr->monster_level = floor_ptr->base_level + 11;
+        /* Monster and/or object */
+        case ',': {
+            if (randint0(100) < 50) {
+                floor_ptr->monster_level = floor_ptr->base_level + 3;
                 place_monster(player_ptr, y, x, (PM_ALLOW_SLEEP | PM_ALLOW_GROUP));
                 floor_ptr->monster_level = floor_ptr->base_level;
-                break;
             }
-
-            /* Meaner monster, plus treasure */
-            case '9': {
-                floor_ptr->monster_level = floor_ptr->base_level + 9;
-                place_monster(player_ptr, y, x, PM_ALLOW_SLEEP);
-                floor_ptr->monster_level = floor_ptr->base_level;
+            if (randint0(100) < 50) {
                 floor_ptr->object_level = floor_ptr->base_level + 7;
-                place_object(player_ptr, y, x, AM_GOOD);
-                floor_ptr->object_level = floor_ptr->base_level;
-                break;
-            }
-
-            /* Nasty monster and treasure */
-            case '8': {
-                floor_ptr->monster_level = floor_ptr->base_level + 40;
-                place_monster(player_ptr, y, x, PM_ALLOW_SLEEP);
-                floor_ptr->monster_level = floor_ptr->base_level;
-                floor_ptr->object_level = floor_ptr->base_level + 20;
-                place_object(player_ptr, y, x, AM_GOOD | AM_GREAT);
+                place_object(player_ptr, y, x, 0L);
                 floor_ptr->object_level = floor_ptr->base_level;
-                break;
-            }
-
-            /* Monster and/or object */
-            case ',': {
-                if (randint0(100) < 50) {
-                    floor_ptr->monster_level = floor_ptr->base_level + 3;
-                    place_monster(player_ptr, y, x, (PM_ALLOW_SLEEP | PM_ALLOW_GROUP));
-                    floor_ptr->monster_level = floor_ptr->base_level;
-                }
-                if (randint0(100) < 50) {
-                    floor_ptr->object_level = floor_ptr->base_level + 7;
-                    place_object(player_ptr, y, x, 0L);
-                    floor_ptr->object_level = floor_ptr->base_level;
-                }
-                break;
-            }
             }
+            break;
+        }
         }
     }
 }
@@ -608,65 +696,41 @@ static void build_vault(
  */
 bool build_type7(player_type *player_ptr, dun_data_type *dd_ptr)
 {
-    vault_type *v_ptr = NULL;
-    int dummy;
-    POSITION x, y;
     POSITION xval, yval;
-    POSITION xoffset, yoffset;
     int transno;
 
     /* Pick a lesser vault */
-    for (dummy = 0; dummy < SAFE_MAX_ATTEMPTS; dummy++) {
-        /* Access a random vault record */
-        v_ptr = &v_info[randint0(max_v_idx)];
-
-        /* Accept the first lesser vault */
-        if (v_ptr->typ == 7)
-            break;
-    }
+    int v_idx = pick_vault(7);
 
     /* No lesser vault found */
-    if (dummy >= SAFE_MAX_ATTEMPTS) {
+    if (v_idx < 0) {
         msg_print_wizard(player_ptr, CHEAT_DUNGEON, _("小型固定Vaultを配置できませんでした。", "Could not place lesser vault."));
         return false;
     }
 
+    const vault_type *v_ptr = &v_info[v_idx];
+
     /* pick type of transformation (0-7) */
     transno = randint0(8);
 
-    /* calculate offsets */
-    x = v_ptr->wid;
-    y = v_ptr->hgt;
-
     /* Some huge vault cannot be ratated to fit in the dungeon */
     floor_type *floor_ptr = player_ptr->current_floor_ptr;
-    if (x + 2 > floor_ptr->height - 2) {
+    if (v_ptr->wid + 2 > floor_ptr->height - 2) {
         /* Forbid 90 or 270 degree ratation */
         transno &= ~1;
     }
 
-    coord_trans(&x, &y, 0, 0, transno);
-
-    if (x < 0) {
-        xoffset = -x - 1;
-    } else {
-        xoffset = 0;
-    }
-
-    if (y < 0) {
-        yoffset = -y - 1;
-    } else {
-        yoffset = 0;
-    }
+    const vault_template_type &vault = get_vault_template(v_idx);
+    const vault_transform_type &transform = vault.transforms[transno];
 
     /* Find and reserve some space in the dungeon.  Get center of room. */
-    if (!find_space(player_ptr, dd_ptr, &yval, &xval, abs(y), abs(x)))
+    if (!find_space(player_ptr, dd_ptr, &yval, &xval, transform.ysize, transform.xsize))
         return false;
 
     msg_format_wizard(player_ptr, CHEAT_DUNGEON, _("小型Vault(%s)を生成しました。", "Lesser vault (%s)."), v_ptr->name.c_str());
 
     /* Hack -- Build the vault */
-    build_vault(player_ptr, yval, xval, v_ptr->hgt, v_ptr->wid, v_ptr->text.c_str(), xoffset, yoffset, transno);
+    build_vault(player_ptr, yval, xval, vault, transno);
 
     return true;
 }
@@ -676,56 +740,32 @@ bool build_type7(player_type *player_ptr, dun_data_type *dd_ptr)
  */
 bool build_type8(player_type *player_ptr, dun_data_type *dd_ptr)
 {
-    vault_type *v_ptr;
-    int dummy;
     POSITION xval, yval;
-    POSITION x, y;
     int transno;
-    POSITION xoffset, yoffset;
 
     /* Pick a greater vault */
-    for (dummy = 0; dummy < SAFE_MAX_ATTEMPTS; dummy++) {
-        /* Access a random vault record */
-        v_ptr = &v_info[randint0(max_v_idx)];
-
-        /* Accept the first greater vault */
-        if (v_ptr->typ == 8)
-            break;
-    }
+    int v_idx = pick_vault(8);
 
     /* No greater vault found */
-    if (dummy >= SAFE_MAX_ATTEMPTS) {
+    if (v_idx < 0) {
         msg_print_wizard(player_ptr, CHEAT_DUNGEON, _("大型固定Vaultを配置できませんでした。", "Could not place greater vault."));
         return false;
     }
 
+    const vault_type *v_ptr = &v_info[v_idx];
+
     /* pick type of transformation (0-7) */
     transno = randint0(8);
 
-    /* calculate offsets */
-    x = v_ptr->wid;
-    y = v_ptr->hgt;
-
     /* Some huge vault cannot be ratated to fit in the dungeon */
     floor_type *floor_ptr = player_ptr->current_floor_ptr;
-    if (x + 2 > floor_ptr->height - 2) {
+    if (v_ptr->wid + 2 > floor_ptr->height - 2) {
         /* Forbid 90 or 270 degree ratation */
         transno &= ~1;
     }
 
-    coord_trans(&x, &y, 0, 0, transno);
-
-    if (x < 0) {
-        xoffset = -x - 1;
-    } else {
-        xoffset = 0;
-    }
-
-    if (y < 0) {
-        yoffset = -y - 1;
-    } else {
-        yoffset = 0;
-    }
+    const vault_template_type &vault = get_vault_template(v_idx);
+    const vault_transform_type &transform = vault.transforms[transno];
 
     /*
      * Try to allocate space for room.  If fails, exit
@@ -734,13 +774,13 @@ bool build_type8(player_type *player_ptr, dun_data_type *dd_ptr)
      * prevent generation of vaults with no-entrance.
      */
     /* Find and reserve some space in the dungeon.  Get center of room. */
-    if (!find_space(player_ptr, dd_ptr, &yval, &xval, (POSITION)(abs(y) + 2), (POSITION)(abs(x) + 2)))
+    if (!find_space(player_ptr, dd_ptr, &yval, &xval, transform.ysize + 2, transform.xsize + 2))
         return false;
 
     msg_format_wizard(player_ptr, CHEAT_DUNGEON, _("大型固定Vault(%s)を生成しました。", "Greater vault (%s)."), v_ptr->name.c_str());
 
     /* Hack -- Build the vault */
-    build_vault(player_ptr, yval, xval, v_ptr->hgt, v_ptr->wid, v_ptr->text.c_str(), xoffset, yoffset, transno);
+    build_vault(player_ptr, yval, xval, vault, transno);
 
     return true;
 }
@@ -1149,65 +1189,41 @@ bool build_type10(player_type *player_ptr, dun_data_type *dd_ptr)
  */
 bool build_type17(player_type *player_ptr, dun_data_type *dd_ptr)
 {
-    vault_type *v_ptr = NULL;
-    int dummy;
-    POSITION x, y;
     POSITION xval, yval;
-    POSITION xoffset, yoffset;
     int transno;
 
     /* Pick a lesser vault */
-    for (dummy = 0; dummy < SAFE_MAX_ATTEMPTS; dummy++) {
-        /* Access a random vault record */
-        v_ptr = &v_info[randint0(max_v_idx)];
-
-        /* Accept the special fix room. */
-        if (v_ptr->typ == 17)
-            break;
-    }
+    int v_idx = pick_vault(17);
 
     /* No lesser vault found */
-    if (dummy >= SAFE_MAX_ATTEMPTS) {
+    if (v_idx < 0) {
         msg_print_wizard(player_ptr, CHEAT_DUNGEON, _("固定特殊部屋を配置できませんでした。", "Could not place fixed special room."));
         return false;
     }
 
+    const vault_type *v_ptr = &v_info[v_idx];
+
     /* pick type of transformation (0-7) */
     transno = randint0(8);
 
-    /* calculate offsets */
-    x = v_ptr->wid;
-    y = v_ptr->hgt;
-
     /* Some huge vault cannot be ratated to fit in the dungeon */
     floor_type *floor_ptr = player_ptr->current_floor_ptr;
-    if (x + 2 > floor_ptr->height - 2) {
+    if (v_ptr->wid + 2 > floor_ptr->height - 2) {
         /* Forbid 90 or 270 degree ratation */
         transno &= ~1;
     }
 
-    coord_trans(&x, &y, 0, 0, transno);
-
-    if (x < 0) {
-        xoffset = -x - 1;
-    } else {
-        xoffset = 0;
-    }
-
-    if (y < 0) {
-        yoffset = -y - 1;
-    } else {
-        yoffset = 0;
-    }
+    const vault_template_type &vault = get_vault_template(v_idx);
+    const vault_transform_type &transform = vault.transforms[transno];
 
     /* Find and reserve some space in the dungeon.  Get center of room. */
-    if (!find_space(player_ptr, dd_ptr, &yval, &xval, abs(y), abs(x)))
+    if (!find_space(player_ptr, dd_ptr, &yval, &xval, transform.ysize, transform.xsize))
         return false;
 
     msg_format_wizard(player_ptr, CHEAT_DUNGEON, _("特殊固定部屋(%s)を生成しました。", "Special Fixed Room (%s)."), v_ptr->name.c_str());
 
     /* Hack -- Build the vault */
-    build_vault(player_ptr, yval, xval, v_ptr->hgt, v_ptr->wid, v_ptr->text.c_str(), xoffset, yoffset, transno);
+    build_vault(player_ptr, yval, xval, vault, transno);
 
     return true;
 }
@@ -95,8 +95,7 @@ void wr_saved_floor(player_type *player_ptr, saved_floor_type *sf_ptr)
         }
     }
 
-    int dummy_why;
-    ang_sort(player_ptr, templates, &dummy_why, num_temp, ang_sort_comp_cave_temp, ang_sort_swap_cave_temp);
+    ang_sort(templates, num_temp, ang_sort_comp_cave_temp);
 
     /*** Dump templates ***/
     wr_u16b(num_temp);
@@ -39,6 +39,12 @@ void wr_randomizer(void)
     wr_u16b(Rand_place);
     for (int i = 0; i < RAND_DEG; i++)
         wr_u32b(Rand_state[i]);
+
+    for (int i = 0; i < static_cast<int>(RandomStream::MAX); i++) {
+        uint32_t *state = Rand_stream(static_cast<RandomStream>(i));
+        for (int j = 0; j < 4; j++)
+            wr_u32b(state[j]);
+    }
 }
 
 /*!
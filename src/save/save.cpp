@@ -18,6 +18,7 @@
 #include "floor/wild.h"
 #include "game-option/text-display-options.h"
 #include "inventory/inventory-slot-types.h"
+#include "io/async-file-writer.h"
 #include "io/files-util.h"
 #include "io/report.h"
 #include "io/uid-checker.h"
@@ -282,6 +283,7 @@ bool save_player(player_type *player_ptr, save_type type)
     fd_kill(safe);
     safe_setuid_drop();
     update_playtime();
+    flush_async_file_writer();
     bool result = false;
     if (save_player_aux(player_ptr, safe, type)) {
         char temp[1024];
@@ -17,6 +17,7 @@
 #include "io/write-diary.h"
 #include "mind/mind-ninja.h"
 #include "monster-floor/monster-lite.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
 #include "monster-race/race-flags2.h"
@@ -268,8 +269,8 @@ bool earthquake(player_type *caster_ptr, POSITION cy, POSITION cx, POSITION r, M
                 continue;
 
             IDX m_idx_aux = floor_ptr->grid_array[yy][xx].m_idx;
-            floor_ptr->grid_array[yy][xx].m_idx = 0;
-            floor_ptr->grid_array[sy][sx].m_idx = m_idx_aux;
+            set_grid_monster(floor_ptr, yy, xx, 0);
+            set_grid_monster(floor_ptr, sy, sx, m_idx_aux);
             m_ptr->fy = sy;
             m_ptr->fx = sx;
             update_monster(caster_ptr, m_idx_aux, true);
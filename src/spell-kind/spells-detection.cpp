@@ -8,6 +8,7 @@
 #include "grid/feature.h"
 #include "grid/grid.h"
 #include "grid/trap.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags2.h"
 #include "monster-race/race-flags3.h"
@@ -30,6 +31,7 @@
 #include "system/player-type-definition.h"
 #include "util/string-processor.h"
 #include "view/display-messages.h"
+#include <vector>
 
 /*!
  * @brief プレイヤー周辺の地形を感知する
@@ -308,6 +310,19 @@ bool detect_objects_magic(player_type *caster_ptr, POSITION range)
     return detect;
 }
 
+/*!
+ * @brief 感知の範囲内にいるモンスターを列挙する
+ * @param caster_ptr プレーヤーへの参照ポインタ
+ * @param range 効果範囲
+ * @return モンスターIDの一覧 (次の呼び出しまで有効)
+ */
+static const std::vector<MONSTER_IDX> &get_monsters_in_detect_range(player_type *caster_ptr, POSITION range)
+{
+    static std::vector<MONSTER_IDX> monsters;
+    get_monsters_in_range(caster_ptr->current_floor_ptr, caster_ptr->y, caster_ptr->x, range, monsters);
+    return monsters;
+}
+
 /*!
  * @brief 一般のモンスターを感知する / Detect all "normal" monsters on the current panel
  * @param caster_ptr プレーヤーへの参照ポインタ
@@ -320,16 +335,9 @@ bool detect_monsters_normal(player_type *caster_ptr, POSITION range)
         range /= 3;
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
+    for (auto i : get_monsters_in_detect_range(caster_ptr, range)) {
         monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
         monster_race *r_ptr = &r_info[m_ptr->r_idx];
-        if (!monster_is_valid(m_ptr))
-            continue;
-
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-        if (distance(caster_ptr->y, caster_ptr->x, y, x) > range)
-            continue;
 
         if (!(r_ptr->flags2 & RF2_INVISIBLE) || caster_ptr->see_inv) {
             m_ptr->mflag2.set({MFLAG2::MARK, MFLAG2::SHOW});
@@ -359,19 +367,10 @@ bool detect_monsters_invis(player_type *caster_ptr, POSITION range)
         range /= 3;
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
+    for (auto i : get_monsters_in_detect_range(caster_ptr, range)) {
         monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
         monster_race *r_ptr = &r_info[m_ptr->r_idx];
 
-        if (!monster_is_valid(m_ptr))
-            continue;
-
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(caster_ptr->y, caster_ptr->x, y, x) > range)
-            continue;
-
         if (r_ptr->flags2 & RF2_INVISIBLE) {
             if (caster_ptr->monster_race_idx == m_ptr->r_idx) {
                 caster_ptr->window_flags |= (PW_MONSTER);
@@ -404,17 +403,9 @@ bool detect_monsters_evil(player_type *caster_ptr, POSITION range)
         range /= 3;
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
+    for (auto i : get_monsters_in_detect_range(caster_ptr, range)) {
         monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
         monster_race *r_ptr = &r_info[m_ptr->r_idx];
-        if (!monster_is_valid(m_ptr))
-            continue;
-
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(caster_ptr->y, caster_ptr->x, y, x) > range)
-            continue;
 
         if (r_ptr->flags3 & RF3_EVIL) {
             if (is_original_ap(m_ptr)) {
@@ -449,15 +440,8 @@ bool detect_monsters_nonliving(player_type *caster_ptr, POSITION range)
         range /= 3;
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
+    for (auto i : get_monsters_in_detect_range(caster_ptr, range)) {
         monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
-        if (!monster_is_valid(m_ptr))
-            continue;
-
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-        if (distance(caster_ptr->y, caster_ptr->x, y, x) > range)
-            continue;
 
         if (!monster_living(m_ptr->r_idx)) {
             if (caster_ptr->monster_race_idx == m_ptr->r_idx) {
@@ -489,17 +473,9 @@ bool detect_monsters_mind(player_type *caster_ptr, POSITION range)
         range /= 3;
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
+    for (auto i : get_monsters_in_detect_range(caster_ptr, range)) {
         monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
         monster_race *r_ptr = &r_info[m_ptr->r_idx];
-        if (!monster_is_valid(m_ptr))
-            continue;
-
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(caster_ptr->y, caster_ptr->x, y, x) > range)
-            continue;
 
         if (!(r_ptr->flags2 & RF2_EMPTY_MIND)) {
             if (caster_ptr->monster_race_idx == m_ptr->r_idx) {
@@ -532,17 +508,9 @@ bool detect_monsters_string(player_type *caster_ptr, POSITION range, concptr Mat
         range /= 3;
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
+    for (auto i : get_monsters_in_detect_range(caster_ptr, range)) {
         monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
         monster_race *r_ptr = &r_info[m_ptr->r_idx];
-        if (!monster_is_valid(m_ptr))
-            continue;
-
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(caster_ptr->y, caster_ptr->x, y, x) > range)
-            continue;
 
         if (angband_strchr(Match, r_ptr->d_char)) {
             if (caster_ptr->monster_race_idx == m_ptr->r_idx) {
@@ -577,17 +545,9 @@ bool detect_monsters_xxx(player_type *caster_ptr, POSITION range, uint32_t match
         range /= 3;
 
     bool flag = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
+    for (auto i : get_monsters_in_detect_range(caster_ptr, range)) {
         monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
         monster_race *r_ptr = &r_info[m_ptr->r_idx];
-        if (!monster_is_valid(m_ptr))
-            continue;
-
-        POSITION y = m_ptr->fy;
-        POSITION x = m_ptr->fx;
-
-        if (distance(caster_ptr->y, caster_ptr->x, y, x) > range)
-            continue;
 
         if (r_ptr->flags3 & (match_flag)) {
             if (is_original_ap(m_ptr)) {
@@ -13,6 +13,7 @@
 #include "io/input-key-acceptor.h"
 #include "locale/english.h"
 #include "lore/lore-store.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags3.h"
 #include "monster/monster-describer.h"
@@ -24,12 +25,15 @@
 #include "monster/smart-learn-types.h"
 #include "spell/spell-types.h"
 #include "system/floor-type-definition.h"
+#include "system/gamevalue.h"
 #include "system/monster-race-definition.h"
 #include "system/monster-type-definition.h"
 #include "system/player-type-definition.h"
 #include "target/projection-path-calculator.h"
 #include "term/screen-processor.h"
 #include "view/display-messages.h"
+#include <algorithm>
+#include <vector>
 
 /*!
  * @brief 視界内モンスターに魔法効果を与える / Apply a "project()" directly to all viewable monsters
@@ -46,11 +50,14 @@
  */
 bool project_all_los(player_type *caster_ptr, EFFECT_ID typ, HIT_POINT dam)
 {
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
-        monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
-        if (!monster_is_valid(m_ptr))
-            continue;
-
+    floor_type *floor_ptr = caster_ptr->current_floor_ptr;
+    std::vector<MONSTER_IDX> monsters;
+    get_monsters_in_rect(floor_ptr, caster_ptr->y - MAX_SIGHT, caster_ptr->x - MAX_SIGHT, caster_ptr->y + MAX_SIGHT, caster_ptr->x + MAX_SIGHT, monsters);
+
+    /* 効果を受ける順序が乱数や死亡時の処理に影響するため、m_list の順に処理する */
+    std::sort(monsters.begin(), monsters.end());
+    for (auto i : monsters) {
+        monster_type *m_ptr = &floor_ptr->m_list[i];
         POSITION y = m_ptr->fy;
         POSITION x = m_ptr->fx;
         if (!player_has_los_bold(caster_ptr, y, x) || !projectable(caster_ptr, caster_ptr->y, caster_ptr->x, y, x))
@@ -61,8 +68,8 @@ bool project_all_los(player_type *caster_ptr, EFFECT_ID typ, HIT_POINT dam)
 
     BIT_FLAGS flg = PROJECT_JUMP | PROJECT_KILL | PROJECT_HIDE;
     bool obvious = false;
-    for (MONSTER_IDX i = 1; i < caster_ptr->current_floor_ptr->m_max; i++) {
-        monster_type *m_ptr = &caster_ptr->current_floor_ptr->m_list[i];
+    for (auto i : monsters) {
+        monster_type *m_ptr = &floor_ptr->m_list[i];
         if (m_ptr->mflag.has_not(MFLAG::LOS))
             continue;
 
@@ -18,6 +18,7 @@
 #include "main/sound-definitions-table.h"
 #include "main/sound-of-music.h"
 #include "monster-floor/monster-move.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags-resistance.h"
 #include "monster-race/race-flags7.h"
@@ -44,6 +45,7 @@
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <vector>
 
 /*!
  * @brief モンスターとの位置交換処理 / Switch position with a monster.
@@ -173,8 +175,8 @@ bool teleport_away(player_type *caster_ptr, MONSTER_IDX m_idx, POSITION dis, tel
     }
 
     sound(SOUND_TPOTHER);
-    caster_ptr->current_floor_ptr->grid_array[oy][ox].m_idx = 0;
-    caster_ptr->current_floor_ptr->grid_array[ny][nx].m_idx = m_idx;
+    set_grid_monster(caster_ptr->current_floor_ptr, oy, ox, 0);
+    set_grid_monster(caster_ptr->current_floor_ptr, ny, nx, m_idx);
 
     m_ptr->fy = ny;
     m_ptr->fx = nx;
@@ -247,8 +249,8 @@ void teleport_monster_to(player_type *caster_ptr, MONSTER_IDX m_idx, POSITION ty
         return;
 
     sound(SOUND_TPOTHER);
-    caster_ptr->current_floor_ptr->grid_array[oy][ox].m_idx = 0;
-    caster_ptr->current_floor_ptr->grid_array[ny][nx].m_idx = m_idx;
+    set_grid_monster(caster_ptr->current_floor_ptr, oy, ox, 0);
+    set_grid_monster(caster_ptr->current_floor_ptr, ny, nx, m_idx);
 
     m_ptr->fy = ny;
     m_ptr->fx = nx;
@@ -261,6 +263,15 @@ void teleport_monster_to(player_type *caster_ptr, MONSTER_IDX m_idx, POSITION ty
         caster_ptr->update |= (PU_MON_LITE);
 }
 
+/*!
+ * @brief プレイヤーのテレポート先の候補地 / A grid the player may teleport to
+ */
+struct teleport_candidate_type {
+    POSITION y;
+    POSITION x;
+    int dist; //!< テレポート前の位置からの距離
+};
+
 /*!
  * @brief プレイヤーのテレポート先選定と移動処理 /
  * Teleport the player to a location up to "dis" grids away.
@@ -301,25 +312,27 @@ bool teleport_player_aux(player_type *creature_ptr, POSITION dis, bool is_quantu
     if (dis > MAX_TELEPORT_DISTANCE)
         dis = MAX_TELEPORT_DISTANCE;
 
+    /* 候補地は走査順に記録しておき、選び直す際は判定をやり直さない */
+    std::vector<teleport_candidate_type> candidates;
     int left = MAX(1, creature_ptr->x - dis);
     int right = MIN(creature_ptr->current_floor_ptr->width - 2, creature_ptr->x + dis);
     int top = MAX(1, creature_ptr->y - dis);
     int bottom = MIN(creature_ptr->current_floor_ptr->height - 2, creature_ptr->y + dis);
-    int total_candidates = 0;
     for (POSITION y = top; y <= bottom; y++) {
         for (POSITION x = left; x <= right; x++) {
-            if (!cave_player_teleportable_bold(creature_ptr, y, x, mode))
-                continue;
-
             int d = distance(creature_ptr->y, creature_ptr->x, y, x);
             if (d > dis)
                 continue;
 
-            total_candidates++;
+            if (!cave_player_teleportable_bold(creature_ptr, y, x, mode))
+                continue;
+
+            candidates.push_back({ y, x, d });
             candidates_at[d]++;
         }
     }
 
+    int total_candidates = static_cast<int>(candidates.size());
     if (0 == total_candidates)
         return false;
 
@@ -334,25 +347,17 @@ bool teleport_player_aux(player_type *creature_ptr, POSITION dis, bool is_quantu
     int pick = randint1(cur_candidates);
 
     /* Search again the choosen location */
-    POSITION yy, xx = 0;
-    for (yy = top; yy <= bottom; yy++) {
-        for (xx = left; xx <= right; xx++) {
-            if (!cave_player_teleportable_bold(creature_ptr, yy, xx, mode))
-                continue;
-
-            int d = distance(creature_ptr->y, creature_ptr->x, yy, xx);
-            if (d > dis)
-                continue;
-            if (d < min)
-                continue;
-
-            pick--;
-            if (!pick)
-                break;
-        }
-
-        if (!pick)
+    POSITION yy = 0, xx = 0;
+    for (const auto &candidate : candidates) {
+        if (candidate.dist < min)
+            continue;
+
+        pick--;
+        if (!pick) {
+            yy = candidate.y;
+            xx = candidate.x;
             break;
+        }
     }
 
     if (player_bold(creature_ptr, yy, xx))
@@ -5,9 +5,12 @@
  */
 
 #include "spell/range-calc.h"
+#include "effect/spells-effect-util.h"
 #include "floor/cave.h"
+#include "floor/distance-ring.h"
 #include "floor/geometry.h"
 #include "floor/line-of-sight.h"
+#include "grid/feature-flag-types.h"
 #include "grid/feature.h"
 #include "grid/grid.h"
 #include "spell/spell-types.h"
@@ -15,6 +18,7 @@
 #include "system/player-type-definition.h"
 #include "target/projection-path-calculator.h"
 #include "util/bit-flags-calculator.h"
+#include <vector>
 
 /*
  * Find the distance from (x, y) to a line.
@@ -207,6 +211,181 @@ bool in_disintegration_range(floor_type *floor_ptr, POSITION y1, POSITION x1, PO
 }
 
 
+/*!
+ * @brief ボールの中心から各グリッドへの射線情報 / Projection path from the center of a ball to a grid
+ */
+struct ball_ray_type {
+	POSITION y; //!< 中心からの相対Y座標
+	POSITION x; //!< 中心からの相対X座標
+	int path_length; //!< 終点直前のグリッドでprojection_path()が射程判定に用いる長さ
+	std::vector<ring_offset_type> via; //!< 終点を除く経路上のグリッド
+};
+
+/*!
+ * @brief 距離ごとの射線情報テーブル / Projection paths, grouped by their distance from the center
+ */
+static std::vector<std::vector<ball_ray_type>> ball_rays;
+
+/*!
+ * @brief 地形を考慮せずに射線経路を求める / Trace the path of projection_path() ignoring the terrain
+ * @param ray_ptr 射線情報への参照ポインタ
+ * @details projection_path() と同じ手順で経路を辿るので、両者は必ず同時に変更すること。
+ */
+static void trace_ball_ray(ball_ray_type *ray_ptr)
+{
+	POSITION ay = ABS(ray_ptr->y);
+	POSITION ax = ABS(ray_ptr->x);
+	POSITION sy = (ray_ptr->y < 0) ? -1 : 1;
+	POSITION sx = (ray_ptr->x < 0) ? -1 : 1;
+	int half = ay * ax;
+	int full = half << 1;
+	int m = 0;
+	int frac = 0;
+	int k = 0;
+	POSITION y = 0;
+	POSITION x = 0;
+	if (ay > ax) {
+		m = ax * ax * 2;
+		y = sy;
+		frac = m;
+		if (frac > half) {
+			x += sx;
+			frac -= full;
+			k++;
+		}
+	} else if (ax > ay) {
+		m = ay * ay * 2;
+		x = sx;
+		frac = m;
+		if (frac > half) {
+			y += sy;
+			frac -= full;
+			k++;
+		}
+	} else {
+		y = sy;
+		x = sx;
+	}
+
+	ray_ptr->path_length = 0;
+	for (int n = 1; (y != ray_ptr->y) || (x != ray_ptr->x); n++) {
+		if ((ABS(y) > ay) || (ABS(x) > ax)) {
+			ray_ptr->path_length = MAX_SHORT;
+			return;
+		}
+
+		ray_ptr->via.push_back({ y, x });
+		ray_ptr->path_length = (ay == ax) ? (n + (n >> 1)) : (n + (k >> 1));
+		if (ay == ax) {
+			y += sy;
+			x += sx;
+			continue;
+		}
+
+		if ((m != 0) && ((frac += m) > half)) {
+			if (ay > ax)
+				x += sx;
+			else
+				y += sy;
+
+			frac -= full;
+			k++;
+		}
+
+		if (ay > ax)
+			y += sy;
+		else
+			x += sx;
+	}
+}
+
+/*!
+ * @brief 中心から指定距離にあるグリッドへの射線情報を返す / Get the projection paths to the grids at the given distance
+ * @param dist 中心からの距離
+ * @return 射線情報の一覧 (get_distance_ring() と同じ順序)
+ */
+static const std::vector<ball_ray_type> &get_ball_rays(POSITION dist)
+{
+	for (POSITION d = static_cast<POSITION>(ball_rays.size()); d <= dist; d++) {
+		std::vector<ball_ray_type> rays;
+		for (const auto &offset : get_distance_ring(d)) {
+			ball_ray_type ray{ offset.y, offset.x, 0, {} };
+			trace_ball_ray(&ray);
+			rays.push_back(std::move(ray));
+		}
+
+		ball_rays.push_back(std::move(rays));
+	}
+
+	return ball_rays[dist];
+}
+
+/*
+ * ball shape
+ */
+void ball_shape(player_type *caster_ptr, int *pgrids, POSITION *gx, POSITION *gy, POSITION *gm, POSITION rad, POSITION by, POSITION bx, EFFECT_ID typ)
+{
+	floor_type *floor_ptr = caster_ptr->current_floor_ptr;
+	int range = project_length ? project_length : get_max_range(caster_ptr);
+
+	/* Whether each grid around the center lets a ball pass (0: unknown, 1: open, 2: blocked) */
+	POSITION side = rad * 2 + 1;
+	std::vector<byte> open_grids(side * side, 0);
+	auto is_open_grid = [&](const ring_offset_type &offset) {
+		byte &open = open_grids[(offset.y + rad) * side + (offset.x + rad)];
+		if (open == 0) {
+			POSITION y = by + offset.y;
+			POSITION x = bx + offset.x;
+			open = (in_bounds(floor_ptr, y, x) && cave_has_flag_bold(floor_ptr, y, x, FF::PROJECT)) ? 1 : 2;
+		}
+
+		return open == 1;
+	};
+
+	for (POSITION dist = 0; dist <= rad; dist++) {
+		for (const auto &ray : get_ball_rays(dist)) {
+			POSITION y = by + ray.y;
+			POSITION x = bx + ray.x;
+			if (!in_bounds2(floor_ptr, y, x)) continue;
+
+			switch (typ)
+			{
+			case GF_LITE:
+			case GF_LITE_WEAK:
+				/* Lights are stopped by opaque terrains */
+				if (!los(caster_ptr, by, bx, y, x)) continue;
+				break;
+			case GF_DISINTEGRATE:
+				/* Disintegration are stopped only by perma-walls */
+				if (!in_disintegration_range(floor_ptr, by, bx, y, x)) continue;
+				break;
+			default: {
+				/* Ball explosions are stopped by walls (same as projectable()) */
+				if (ray.via.empty()) break;
+				if (ray.path_length >= range) continue;
+
+				bool is_blocked = false;
+				for (const auto &via : ray.via) {
+					if (!is_open_grid(via)) {
+						is_blocked = true;
+						break;
+					}
+				}
+
+				if (is_blocked) continue;
+				break;
+			}
+			}
+
+			gy[*pgrids] = y;
+			gx[*pgrids] = x;
+			(*pgrids)++;
+		}
+
+		gm[dist + 1] = *pgrids;
+	}
+}
+
 /*
  * breath shape
  */
@@ -89,15 +89,7 @@ void do_cmd_store(player_type *player_ptr)
         return;
     }
 
-    int maintain_num = (current_world_ptr->game_turn - town_info[player_ptr->town_num].store[which].last_visit) / (TURNS_PER_TICK * STORE_TICKS);
-    if (maintain_num > 10)
-        maintain_num = 10;
-    if (maintain_num) {
-        store_maintenance(player_ptr, player_ptr->town_num, which, maintain_num);
-
-        town_info[player_ptr->town_num].store[which].last_visit = current_world_ptr->game_turn;
-    }
-
+    store_catch_up(player_ptr, player_ptr->town_num, which);
     forget_lite(player_ptr->current_floor_ptr);
     forget_view(player_ptr->current_floor_ptr);
     current_world_ptr->character_icky_depth = 1;
@@ -9,6 +9,7 @@
 #include "system/object-type-definition.h"
 #include "system/player-type-definition.h"
 #include "util/object-sort.h"
+#include <vector>
 
 /*!
  * @brief 我が家にオブジェクトを加える /
@@ -32,7 +33,7 @@ int home_carry(player_type *player_ptr, object_type *o_ptr)
         stack_force_costs = false;
     }
 
-    for (int slot = 0; slot < st_ptr->stock_num; slot++) {
+    for (int slot : ObjectStackIndex(st_ptr->stock, st_ptr->stock_num).find(o_ptr)) {
         object_type *j_ptr;
         j_ptr = &st_ptr->stock[slot];
         if (object_similar(j_ptr, o_ptr)) {
@@ -98,13 +99,14 @@ static bool exe_combine_store_items(object_type *o_ptr, object_type *j_ptr, cons
     return true;
 }
 
-static void sweep_reorder_store_item(object_type *o_ptr, const int i, bool *combined)
+static void sweep_reorder_store_item(const ObjectStackIndex &stack_index, object_type *o_ptr, const int i, bool *combined)
 {
-    for (int j = 0; j < i; j++) {
+    for (int j : stack_index.find(o_ptr)) {
+        if (j >= i)
+            break;
+
         object_type *j_ptr;
         j_ptr = &st_ptr->stock[j];
-        if (!j_ptr->k_idx)
-            continue;
 
         int max_num = object_similar_part(j_ptr, o_ptr);
         if (max_num == 0 || j_ptr->number >= max_num)
@@ -131,16 +133,21 @@ static void sweep_reorder_store_item(object_type *o_ptr, const int i, bool *comb
 
 static void exe_reorder_store_item(player_type *player_ptr, bool *flag)
 {
+    /* 価値は並べ替えの前に一度だけ計算し、アイテムと一緒に動かす */
+    std::vector<int32_t> values(st_ptr->stock_num);
+    for (int i = 0; i < st_ptr->stock_num; i++)
+        values[i] = st_ptr->stock[i].k_idx ? object_value(player_ptr, &st_ptr->stock[i]) : 0;
+
     for (int i = 0; i < st_ptr->stock_num; i++) {
         object_type *o_ptr;
         o_ptr = &st_ptr->stock[i];
         if (!o_ptr->k_idx)
             continue;
 
-        int32_t o_value = object_value(player_ptr, o_ptr);
+        int32_t o_value = values[i];
         int j;
         for (j = 0; j < st_ptr->stock_num; j++)
-            if (object_sort_comp(player_ptr, o_ptr, o_value, &st_ptr->stock[j]))
+            if (object_sort_comp(player_ptr, o_ptr, o_value, &st_ptr->stock[j], values[j]))
                 break;
 
         if (j >= i)
@@ -151,10 +158,13 @@ static void exe_reorder_store_item(player_type *player_ptr, bool *flag)
         object_type forge;
         j_ptr = &forge;
         j_ptr->copy_from(&st_ptr->stock[i]);
-        for (int k = i; k > j; k--)
+        for (int k = i; k > j; k--) {
             (&st_ptr->stock[k])->copy_from(&st_ptr->stock[k - 1]);
+            values[k] = values[k - 1];
+        }
 
         (&st_ptr->stock[j])->copy_from(j_ptr);
+        values[j] = o_value;
     }
 }
 
@@ -179,13 +189,14 @@ bool combine_and_reorder_home(player_type *player_ptr, const int store_num)
     bool combined = true;
     while (combined) {
         combined = false;
+        ObjectStackIndex stack_index(st_ptr->stock, st_ptr->stock_num);
         for (int i = st_ptr->stock_num - 1; i > 0; i--) {
             object_type *o_ptr;
             o_ptr = &st_ptr->stock[i];
             if (!o_ptr->k_idx)
                 continue;
 
-            sweep_reorder_store_item(o_ptr, i, &combined);
+            sweep_reorder_store_item(stack_index, o_ptr, i, &combined);
         }
 
         flag |= combined;
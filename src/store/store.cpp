@@ -32,6 +32,7 @@
 #include "util/int-char-converter.h"
 #include "util/quarks.h"
 #include "view/display-messages.h"
+#include "world/world.h"
 #ifdef JP
 #include "locale/japanese.h"
 #endif
@@ -245,6 +246,8 @@ void store_shuffle(player_type *player_ptr, int which)
     if ((which == STORE_HOME) || (which == STORE_MUSEUM))
         return;
 
+    RandomStreamScope rand_scope(RandomStream::STORE);
+
     cur_store_num = which;
     st_ptr = &town_info[player_ptr->town_num].store[cur_store_num];
     int j = st_ptr->owner;
@@ -282,13 +285,38 @@ void store_shuffle(player_type *player_ptr, int which)
     }
 }
 
+/*!
+ * @brief 複数日分の入れ替え品数を決める /
+ * Decide how many slots turn over during several days
+ * @param remain 入れ替わり得る品数の上限
+ * @param days 経過日数
+ * @return 入れ替える品数
+ * @details
+ * 1日ごとに残りの上限から乱数で品数を選んで足し込む。
+ * 日を追うごとに上限が減るため、日数が増えるほど上限に張り付いた状態 (品揃えが一巡した状態) に近づく。
+ */
+static int store_turnover_count(int remain, int days)
+{
+    int turn_over = 1;
+    for (int i = 0; i < days; i++) {
+        auto n = randint0(remain);
+        turn_over += n;
+        remain -= n;
+    }
+
+    return turn_over;
+}
+
 /*!
  * @brief 店の品揃えを変化させる /
  * Maintain the inventory at the stores.
  * @param player_ptr プレーヤーへの参照ポインタ
  * @param town_num 町のID
  * @param store_num 店舗種類のID
- * @param chance 更新商品数
+ * @param chance 経過日数
+ * @details
+ * 複数日分の売買は日ごとに繰り返さず、入れ替える品数を日数分まとめて決めてから
+ * 品物の削除と作成をそれぞれ一度ずつ行う。
  */
 void store_maintenance(player_type *player_ptr, int town_num, int store_num, int chance)
 {
@@ -296,6 +324,7 @@ void store_maintenance(player_type *player_ptr, int town_num, int store_num, int
     if ((store_num == STORE_HOME) || (store_num == STORE_MUSEUM))
         return;
 
+    RandomStreamScope rand_scope(RandomStream::STORE);
     st_ptr = &town_info[town_num].store[store_num];
     ot_ptr = &owners[store_num][st_ptr->owner];
     st_ptr->insult_cur = 0;
@@ -310,15 +339,7 @@ void store_maintenance(player_type *player_ptr, int town_num, int store_num, int
     }
 
     INVENTORY_IDX j = st_ptr->stock_num;
-    int remain = STORE_TURNOVER + MAX(0, j - STORE_MAX_KEEP);
-    int turn_over = 1;
-    for (int i = 0; i < chance; i++) {
-        auto n = randint0(remain);
-        turn_over += n;
-        remain -= n;
-    }
-
-    j = j - turn_over;
+    j = j - store_turnover_count(STORE_TURNOVER + MAX(0, j - STORE_MAX_KEEP), chance);
     if (j > STORE_MAX_KEEP)
         j = STORE_MAX_KEEP;
     if (j < STORE_MIN_KEEP)
@@ -327,15 +348,7 @@ void store_maintenance(player_type *player_ptr, int town_num, int store_num, int
     while (st_ptr->stock_num > j)
         store_delete();
 
-    remain = STORE_MAX_KEEP - st_ptr->stock_num;
-    turn_over = 1;
-    for (int i = 0; i < chance; i++) {
-        auto n = randint0(remain);
-        turn_over += n;
-        remain -= n;
-    }
-
-    j = st_ptr->stock_num + turn_over;
+    j = st_ptr->stock_num + store_turnover_count(STORE_MAX_KEEP - st_ptr->stock_num, chance);
     if (j > STORE_MAX_KEEP)
         j = STORE_MAX_KEEP;
     if (j < STORE_MIN_KEEP)
@@ -353,6 +366,27 @@ void store_maintenance(player_type *player_ptr, int town_num, int store_num, int
         store_create(player_ptr, 0, black_market_crap, store_will_buy, mass_produce);
 }
 
+/*!
+ * @brief 前回の来店から経過した日数分だけ店の品揃えを進める /
+ * Bring the stock of a store up to date when the player enters it
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @param town_num 町のID
+ * @param store_num 店舗種類のID
+ * @details
+ * 店の品揃えは町に戻った時ではなく、プレイヤーがその店に入った時にだけ作られる。
+ * STORE_MAX_CATCH_UP 日を超えて空いた分は品揃えが一巡したものとみなし、それ以上は進めない。
+ */
+void store_catch_up(player_type *player_ptr, int town_num, int store_num)
+{
+    store_type *store_ptr = &town_info[town_num].store[store_num];
+    int days = (current_world_ptr->game_turn - store_ptr->last_visit) / (TURNS_PER_TICK * STORE_TICKS);
+    if (days == 0)
+        return;
+
+    store_maintenance(player_ptr, town_num, store_num, MIN(days, STORE_MAX_CATCH_UP));
+    store_ptr->last_visit = current_world_ptr->game_turn;
+}
+
 /*!
  * @brief 店舗情報を初期化する /
  * Initialize the stores
@@ -383,7 +417,7 @@ void store_init(int town_num, int store_num)
     st_ptr->good_buy = 0;
     st_ptr->bad_buy = 0;
     st_ptr->stock_num = 0;
-    st_ptr->last_visit = -10L * TURNS_PER_TICK * STORE_TICKS;
+    st_ptr->last_visit = -STORE_MAX_CATCH_UP * TURNS_PER_TICK * STORE_TICKS;
     for (int k = 0; k < st_ptr->stock_size; k++)
         (&st_ptr->stock[k])->wipe();
 }
@@ -10,6 +10,7 @@
 #define STORE_MAX_KEEP  21              /* Max slots to "always" keep full */
 #define STORE_SHUFFLE   21              /* 1/Chance (per day) of an owner changing */
 #define STORE_TICKS     1000            /* Number of ticks between turnovers */
+#define STORE_MAX_CATCH_UP 10           /* Max days of turnover applied on entering */
 
 typedef struct owner_type owner_type;
 extern int store_top;
@@ -26,6 +27,7 @@ typedef struct player_type player_type;
 int16_t store_get_stock_max(STORE_TYPE_IDX store_idx, bool powerup = true);
 void store_shuffle(player_type *player_ptr, int which);
 void store_maintenance(player_type *player_ptr, int town_num, int store_num, int chance);
+void store_catch_up(player_type *player_ptr, int town_num, int store_num);
 void store_init(int town_num, int store_num);
 void store_examine(player_type *player_ptr);
 int store_check_num(object_type *o_ptr);
@@ -29,6 +29,9 @@ typedef struct floor_type {
     MONSTER_IDX m_max; /* Number of allocated monsters */
     MONSTER_IDX m_cnt; /* Number of live monsters */
 
+    MONSTER_NUMBER mon_block_num[MONSTER_BLOCK_HGT][MONSTER_BLOCK_WID]; /*!< 区画ごとのモンスター数 / Number of monsters in each block */
+    MONSTER_NUMBER mon_block_total; /*!< 区画に登録されているモンスターの総数 / Total number of monsters registered in blocks */
+
     int16_t *mproc_list[MAX_MTIMED]; /*!< The array to process dungeon monsters[max_m_idx] */
     int16_t mproc_max[MAX_MTIMED]; /*!< Number of monsters to be processed */
 
@@ -42,8 +42,12 @@ void object_type::prep(player_type *player_ptr, KIND_OBJECT_IDX ko_idx)
 {
     object_kind *k_ptr = &k_info[ko_idx];
     auto old_stack_idx = this->stack_idx;
+    auto old_next_o_idx = this->next_o_idx;
+    auto old_prev_o_idx = this->prev_o_idx;
     wipe();
     this->stack_idx = old_stack_idx;
+    this->next_o_idx = old_next_o_idx;
+    this->prev_o_idx = old_prev_o_idx;
     this->k_idx = ko_idx;
     this->tval = k_ptr->tval;
     this->sval = k_ptr->sval;
@@ -12,6 +12,19 @@
 #include "system/angband.h"
 #include "system/system-variables.h"
 #include "util/flag-group.h"
+#include <array>
+
+/*!
+ * @brief object_value_real() の計算結果のキャッシュ
+ * @details 価格の計算に使うフィールドの写しを持ち、写しが現在の値と一致する間だけ value を使い回す。
+ */
+struct object_value_cache_type {
+    bool valid{}; /*!< 計算済みか否か */
+    std::array<int32_t, 16> fields{}; /*!< 計算した時点の数値フィールドの写し */
+    TrFlags art_flags{}; /*!< 計算した時点の追加フラグの写し */
+    EnumClassFlagGroup<TRC> curse_flags{}; /*!< 計算した時点の呪いフラグの写し */
+    PRICE value{}; /*!< 計算結果 */
+};
 
 struct player_type;
 typedef struct object_type {
@@ -19,6 +32,8 @@ typedef struct object_type {
     POSITION iy{}; /*!< Y-position on map, or zero */
     POSITION ix{}; /*!< X-position on map, or zero */
     IDX stack_idx{}; /*!< このアイテムを含むアイテムリスト内の位置(降順) */
+    OBJECT_IDX next_o_idx{}; /*!< このアイテムを含むアイテムリスト内の次のアイテム (最後尾なら0) */
+    OBJECT_IDX prev_o_idx{}; /*!< このアイテムを含むアイテムリスト内の前のアイテム (先頭なら0) */
     tval_type tval{}; /*!< Item type (from kind) */
 
     OBJECT_SUBTYPE_VALUE sval{}; /*!< Item sub-type (from kind) */
@@ -53,6 +68,7 @@ typedef struct object_type {
     EnumClassFlagGroup<TRC> curse_flags{}; /*!< Flags for curse */
     MONSTER_IDX held_m_idx{}; /*!< アイテムを所持しているモンスターID (いないなら 0) / Monster holding us (if any) */
     int artifact_bias{}; /*!< ランダムアーティファクト生成時のバイアスID */
+    object_value_cache_type value_cache{}; /*!< 本価格のキャッシュ (セーブしない) */
 
     void wipe();
     void copy_from(object_type *j_ptr);
@@ -76,7 +76,12 @@ static void tgt_pt_prepare(player_type *creature_ptr, std::vector<POSITION> &ys,
         }
     }
 
-    ang_sort(creature_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_distance, ang_sort_swap_position);
+    ang_sort(
+        size(ys), [creature_ptr, &ys, &xs](int a, int b) { return ang_sort_comp_distance(creature_ptr, ys[a], xs[a], ys[b], xs[b]); },
+        [&ys, &xs](int a, int b) {
+            std::swap(ys[a], ys[b]);
+            std::swap(xs[a], xs[b]);
+        });
 }
 
 /*!
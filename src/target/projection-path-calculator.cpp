@@ -6,6 +6,7 @@
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
 #include "system/player-type-definition.h"
+#include "world/world.h"
 
 typedef struct projection_path_type {
     uint16_t *gp;
@@ -237,16 +238,82 @@ int projection_path(player_type *player_ptr, uint16_t *gp, POSITION range, POSIT
     return pp_ptr->n;
 }
 
-/*
- * Determine if a bolt spell cast from (y1,x1) to (y2,x2) will arrive
- * at the final destination, assuming no monster gets in the way.
- *
- * This is slightly (but significantly) different from "los(y1,x1,y2,x2)".
+/*!
+ * @brief プレイヤーとの射線判定を保持する範囲(マス) / Radius of the projectable field around the player
  */
-bool projectable(player_type *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+#define PROJECTABLE_FIELD_RAD 36
+
+/*!
+ * @brief プレイヤーとの射線判定を保持する配列の一辺 / Side length of the projectable field
+ */
+#define PROJECTABLE_FIELD_SIDE (PROJECTABLE_FIELD_RAD * 2 + 1)
+
+/*!
+ * @brief プレイヤーを中心とした射線判定結果のキャッシュ / Cache of projectable() results between the player and nearby grids
+ * @details
+ * モンスターのAIは毎ターン多数のグリッドとプレイヤーとの間でprojectable()を呼ぶ。
+ * 結果は地形とプレイヤーの位置と射程だけで決まるため、それらが変わるまで保持しておく。
+ * 各要素は 0: 未計算 / 1: 射線が通る / 2: 射線が通らない を表す。
+ */
+typedef struct projectable_field_type {
+    bool valid; //!< キャッシュが有効か
+    floor_type *floor_ptr; //!< 計算したフロア
+    POSITION y; //!< 計算したときのプレイヤーのY座標
+    POSITION x; //!< 計算したときのプレイヤーのX座標
+    POSITION range; //!< 計算したときの射程
+    byte from_player[PROJECTABLE_FIELD_SIDE][PROJECTABLE_FIELD_SIDE]; //!< プレイヤーから各グリッドへの射線
+    byte to_player[PROJECTABLE_FIELD_SIDE][PROJECTABLE_FIELD_SIDE]; //!< 各グリッドからプレイヤーへの射線
+} projectable_field_type;
+
+static projectable_field_type projectable_field;
+
+/*!
+ * @brief 任意の中心からの射線判定を保持する範囲(マス) / Radius of the projectable fields around other centers
+ */
+#define PROJECTABLE_AROUND_RAD 9
+
+/*!
+ * @brief 任意の中心からの射線判定を保持する配列の一辺 / Side length of the projectable fields around other centers
+ */
+#define PROJECTABLE_AROUND_SIDE (PROJECTABLE_AROUND_RAD * 2 + 1)
+
+/*!
+ * @brief 任意の中心からの射線判定を同時に保持する数 / Number of centers cached at once
+ */
+#define PROJECTABLE_AROUND_MAX 4
+
+/*!
+ * @brief 任意の中心から周囲のグリッドへの射線判定結果のキャッシュ / Cache of projectable() results from a center to nearby grids
+ * @details
+ * 召喚や増殖では同じ地点の周囲に何度もモンスターを配置しようとするため、中心毎に結果を保持する。
+ * 要素の意味は projectable_field_type と同じ。
+ */
+typedef struct projectable_around_type {
+    bool valid; //!< キャッシュが有効か
+    floor_type *floor_ptr; //!< 計算したフロア
+    POSITION y; //!< 中心のY座標
+    POSITION x; //!< 中心のX座標
+    POSITION range; //!< 計算したときの射程
+    byte to_grid[PROJECTABLE_AROUND_SIDE][PROJECTABLE_AROUND_SIDE]; //!< 中心から各グリッドへの射線
+} projectable_around_type;
+
+static projectable_around_type projectable_around_fields[PROJECTABLE_AROUND_MAX];
+static int projectable_around_next = 0; //!< 次に置き換えるキャッシュの添字
+
+/*!
+ * @brief 射線が目標地点に届くかを経路を計算して判定する / Trace a projection path and check whether it arrives at the destination
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @param range 射程
+ * @param y1 始点Y座標
+ * @param x1 始点X座標
+ * @param y2 終点Y座標
+ * @param x2 終点X座標
+ * @return 射線が届くならばTRUE
+ */
+static bool trace_projectable(player_type *player_ptr, POSITION range, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
     uint16_t grid_g[512];
-    int grid_n = projection_path(player_ptr, grid_g, (project_length ? project_length : get_max_range(player_ptr)), y1, x1, y2, x2, 0);
+    int grid_n = projection_path(player_ptr, grid_g, range, y1, x1, y2, x2, 0);
     if (!grid_n)
         return true;
 
@@ -258,6 +325,123 @@ bool projectable(player_type *player_ptr, POSITION y1, POSITION x1, POSITION y2,
     return true;
 }
 
+/*!
+ * @brief プレイヤーとの射線判定のキャッシュを破棄する / Forget the cached projectable() results around the player
+ * @details 地形が変わった時やフロアを移動した時に呼ぶこと。
+ */
+void forget_projectable_field(void)
+{
+    projectable_field.valid = false;
+    for (auto &field : projectable_around_fields)
+        field.valid = false;
+}
+
+/*!
+ * @brief プレイヤーとの射線判定のキャッシュを参照する / Get the cache entry of projectable() between the player and a grid
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @param range 射程
+ * @param y 対象グリッドのY座標
+ * @param x 対象グリッドのX座標
+ * @param to_player 対象グリッドからプレイヤーへの射線ならばTRUE、プレイヤーから対象グリッドへの射線ならばFALSE
+ * @return キャッシュの要素への参照ポインタ。キャッシュの範囲外ならばnullptr
+ */
+static byte *get_projectable_field_entry(player_type *player_ptr, POSITION range, POSITION y, POSITION x, bool to_player)
+{
+    if (!current_world_ptr->character_dungeon)
+        return nullptr;
+
+    POSITION dy = y - player_ptr->y + PROJECTABLE_FIELD_RAD;
+    POSITION dx = x - player_ptr->x + PROJECTABLE_FIELD_RAD;
+    if ((dy < 0) || (dy >= PROJECTABLE_FIELD_SIDE) || (dx < 0) || (dx >= PROJECTABLE_FIELD_SIDE))
+        return nullptr;
+
+    projectable_field_type *field_ptr = &projectable_field;
+    if (!field_ptr->valid || (field_ptr->floor_ptr != player_ptr->current_floor_ptr) || (field_ptr->y != player_ptr->y) || (field_ptr->x != player_ptr->x)
+        || (field_ptr->range != range)) {
+        *field_ptr = {};
+        field_ptr->floor_ptr = player_ptr->current_floor_ptr;
+        field_ptr->y = player_ptr->y;
+        field_ptr->x = player_ptr->x;
+        field_ptr->range = range;
+        field_ptr->valid = true;
+    }
+
+    return to_player ? &field_ptr->to_player[dy][dx] : &field_ptr->from_player[dy][dx];
+}
+
+/*
+ * Determine if a bolt spell cast from (y1,x1) to (y2,x2) will arrive
+ * at the final destination, assuming no monster gets in the way.
+ *
+ * This is slightly (but significantly) different from "los(y1,x1,y2,x2)".
+ *
+ * Results between the player and a grid are cached until the player
+ * moves or the terrain changes, since the monster AI asks them many times.
+ */
+bool projectable(player_type *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+{
+    POSITION range = project_length ? project_length : get_max_range(player_ptr);
+    byte *entry = nullptr;
+    if (player_bold(player_ptr, y2, x2))
+        entry = get_projectable_field_entry(player_ptr, range, y1, x1, true);
+    else if (player_bold(player_ptr, y1, x1))
+        entry = get_projectable_field_entry(player_ptr, range, y2, x2, false);
+
+    if (entry == nullptr)
+        return trace_projectable(player_ptr, range, y1, x1, y2, x2);
+
+    if (*entry == 0)
+        *entry = trace_projectable(player_ptr, range, y1, x1, y2, x2) ? 1 : 2;
+
+    return *entry == 1;
+}
+
+/*!
+ * @brief 中心グリッドから周囲のグリッドへ射線が通るかを返す / Determine projectable() from a center, caching the results around it
+ * @param player_ptr プレーヤーへの参照ポインタ
+ * @param y1 中心のY座標
+ * @param x1 中心のX座標
+ * @param y2 対象グリッドのY座標
+ * @param x2 対象グリッドのX座標
+ * @return projectable(player_ptr, y1, x1, y2, x2) と同じ値
+ * @details
+ * 結果は地形が変わるかフロアを移動するまで中心毎に保持するため、同じ中心から繰り返し問い合わせる処理に使う。
+ */
+bool projectable_around(player_type *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
+{
+    POSITION dy = y2 - y1 + PROJECTABLE_AROUND_RAD;
+    POSITION dx = x2 - x1 + PROJECTABLE_AROUND_RAD;
+    if (!current_world_ptr->character_dungeon || player_bold(player_ptr, y1, x1) || player_bold(player_ptr, y2, x2) || (dy < 0)
+        || (dy >= PROJECTABLE_AROUND_SIDE) || (dx < 0) || (dx >= PROJECTABLE_AROUND_SIDE))
+        return projectable(player_ptr, y1, x1, y2, x2);
+
+    POSITION range = project_length ? project_length : get_max_range(player_ptr);
+    projectable_around_type *field_ptr = nullptr;
+    for (auto &field : projectable_around_fields) {
+        if (field.valid && (field.floor_ptr == player_ptr->current_floor_ptr) && (field.y == y1) && (field.x == x1) && (field.range == range)) {
+            field_ptr = &field;
+            break;
+        }
+    }
+
+    if (field_ptr == nullptr) {
+        field_ptr = &projectable_around_fields[projectable_around_next];
+        projectable_around_next = (projectable_around_next + 1) % PROJECTABLE_AROUND_MAX;
+        *field_ptr = {};
+        field_ptr->floor_ptr = player_ptr->current_floor_ptr;
+        field_ptr->y = y1;
+        field_ptr->x = x1;
+        field_ptr->range = range;
+        field_ptr->valid = true;
+    }
+
+    byte *entry = &field_ptr->to_grid[dy][dx];
+    if (*entry == 0)
+        *entry = trace_projectable(player_ptr, range, y1, x1, y2, x2) ? 1 : 2;
+
+    return *entry == 1;
+}
+
 /*!
  * @briefプレイヤーの攻撃射程(マス) / Maximum range (spells, etc)
  * @param creature_ptr プレーヤーへの参照ポインタ
@@ -3,6 +3,7 @@
 #include "game-option/input-options.h"
 #include "grid/feature.h"
 #include "grid/grid.h"
+#include "monster-floor/monster-spatial-index.h"
 #include "monster-race/monster-race.h"
 #include "monster-race/race-flags1.h"
 #include "monster/monster-flag-types.h"
@@ -112,44 +113,54 @@ static bool target_set_accept(player_type *creature_ptr, POSITION y, POSITION x)
  */
 void target_set_prepare(player_type *creature_ptr, std::vector<POSITION> &ys, std::vector<POSITION> &xs, const BIT_FLAGS mode)
 {
-    POSITION min_hgt, max_hgt, min_wid, max_wid;
-    if (mode & TARGET_KILL) {
-        min_hgt = MAX((creature_ptr->y - get_max_range(creature_ptr)), 0);
-        max_hgt = MIN((creature_ptr->y + get_max_range(creature_ptr)), creature_ptr->current_floor_ptr->height - 1);
-        min_wid = MAX((creature_ptr->x - get_max_range(creature_ptr)), 0);
-        max_wid = MIN((creature_ptr->x + get_max_range(creature_ptr)), creature_ptr->current_floor_ptr->width - 1);
-    } else {
-        min_hgt = panel_row_min;
-        max_hgt = panel_row_max;
-        min_wid = panel_col_min;
-        max_wid = panel_col_max;
-    }
-
     ys.clear();
     xs.clear();
 
-    for (POSITION y = min_hgt; y <= max_hgt; y++) {
-        for (POSITION x = min_wid; x <= max_wid; x++) {
-            grid_type *g_ptr;
-            if (!target_set_accept(creature_ptr, y, x))
-                continue;
-
-            g_ptr = &creature_ptr->current_floor_ptr->grid_array[y][x];
-            if ((mode & (TARGET_KILL)) && !target_able(creature_ptr, g_ptr->m_idx))
+    if (mode & TARGET_KILL) {
+        /* 攻撃対象になり得るのはモンスターのいるグリッドだけなので、範囲内のモンスターを行優先の順で調べる */
+        floor_type *floor_ptr = creature_ptr->current_floor_ptr;
+        POSITION range = get_max_range(creature_ptr);
+        static std::vector<MONSTER_IDX> monsters;
+        get_monsters_in_rect(floor_ptr, creature_ptr->y - range, creature_ptr->x - range, creature_ptr->y + range, creature_ptr->x + range, monsters);
+        std::sort(monsters.begin(), monsters.end(), [floor_ptr](MONSTER_IDX idx1, MONSTER_IDX idx2) {
+            auto m_ptr1 = &floor_ptr->m_list[idx1];
+            auto m_ptr2 = &floor_ptr->m_list[idx2];
+            return std::make_pair(m_ptr1->fy, m_ptr1->fx) < std::make_pair(m_ptr2->fy, m_ptr2->fx);
+        });
+
+        for (auto m_idx : monsters) {
+            monster_type *m_ptr = &floor_ptr->m_list[m_idx];
+            if (!target_set_accept(creature_ptr, m_ptr->fy, m_ptr->fx) || !target_able(creature_ptr, m_idx))
                 continue;
 
-            if ((mode & (TARGET_KILL)) && !target_pet && is_pet(&creature_ptr->current_floor_ptr->m_list[g_ptr->m_idx]))
+            if (!target_pet && is_pet(m_ptr))
                 continue;
 
-            ys.emplace_back(y);
-            xs.emplace_back(x);
+            ys.emplace_back(m_ptr->fy);
+            xs.emplace_back(m_ptr->fx);
+        }
+    } else {
+        for (POSITION y = panel_row_min; y <= panel_row_max; y++) {
+            for (POSITION x = panel_col_min; x <= panel_col_max; x++) {
+                if (!target_set_accept(creature_ptr, y, x))
+                    continue;
+
+                ys.emplace_back(y);
+                xs.emplace_back(x);
+            }
         }
     }
 
+    auto swap_position = [&ys, &xs](int a, int b) {
+        std::swap(ys[a], ys[b]);
+        std::swap(xs[a], xs[b]);
+    };
     if (mode & (TARGET_KILL)) {
-        ang_sort(creature_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_distance, ang_sort_swap_position);
+        ang_sort(
+            size(ys), [creature_ptr, &ys, &xs](int a, int b) { return ang_sort_comp_distance(creature_ptr, ys[a], xs[a], ys[b], xs[b]); }, swap_position);
     } else {
-        ang_sort(creature_ptr, xs.data(), ys.data(), size(ys), ang_sort_comp_importance, ang_sort_swap_position);
+        ang_sort(
+            size(ys), [creature_ptr, &ys, &xs](int a, int b) { return ang_sort_comp_importance(creature_ptr, ys[a], xs[a], ys[b], xs[b]); }, swap_position);
     }
 
     // 乗っているモンスターがターゲットリストの先頭にならないようにする調整。
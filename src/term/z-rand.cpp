@@ -64,6 +64,17 @@ uint32_t Rand_state[RAND_DEG] = {
     88675123,
 };
 
+/*
+ * RNG state used by Rand_div() and its callers.
+ * It points to Rand_state unless a RandomStreamScope is active.
+ */
+static uint32_t *Rand_active = Rand_state;
+
+/*
+ * States of the named RNG streams
+ */
+static uint32_t Rand_stream_state[static_cast<int>(RandomStream::MAX)][4];
+
 static uint32_t u32b_rotl(const uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
 
 /*
@@ -103,9 +114,34 @@ static uint32_t Rand_Xoshiro128starstar(uint32_t *state)
 static const uint32_t Rand_Xorshift_max = 0xFFFFFFFF;
 
 /*
- * Initialize the RNG using a new seed
+ * Advance the RNG state by 2^64 steps.
+ * Calling this N times gives N non-overlapping subsequences of the same
+ * generator.
+ */
+void Rand_state_jump(uint32_t *state)
+{
+    static const uint32_t JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+    uint32_t s[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 32; b++) {
+            if (JUMP[i] & (1U << b)) {
+                for (int j = 0; j < 4; j++)
+                    s[j] ^= state[j];
+            }
+
+            (void)Rand_Xoshiro128starstar(state);
+        }
+    }
+
+    for (int j = 0; j < 4; j++)
+        state[j] = s[j];
+}
+
+/*
+ * Initialize the active RNG using a new seed
  */
-void Rand_state_set(uint32_t seed) { Rand_seed(seed, Rand_state); }
+void Rand_state_set(uint32_t seed) { Rand_seed(seed, Rand_active); }
 
 void Rand_state_init(void)
 {
@@ -147,29 +183,43 @@ void Rand_state_init(void)
 }
 
 /*
- * Backup the RNG state
+ * Backup the active RNG state
  */
 void Rand_state_backup(uint32_t *backup_state)
 {
     int i;
 
     for (i = 0; i < 4; ++i) {
-        backup_state[i] = Rand_state[i];
+        backup_state[i] = Rand_active[i];
     }
 }
 
 /*
- * Restore the RNG state
+ * Restore the active RNG state
  */
 void Rand_state_restore(uint32_t *backup_state)
 {
     int i;
 
     for (i = 0; i < 4; ++i) {
-        Rand_state[i] = backup_state[i];
+        Rand_active[i] = backup_state[i];
     }
 }
 
+/*
+ * Derive an independent RNG state from the active RNG.
+ * The new state is filled with outputs of the active RNG, so the same
+ * active state always yields the same derived state.
+ */
+void Rand_state_split(uint32_t *state)
+{
+    do {
+        for (int i = 0; i < 4; ++i) {
+            state[i] = Rand_Xoshiro128starstar(Rand_active);
+        }
+    } while ((state[0] | state[1] | state[2] | state[3]) == 0);
+}
+
 /*
  * Extract a "random" number from 0 to m-1, via "ENERGY_DIVISION"
  */
@@ -193,7 +243,50 @@ static int32_t Rand_div_impl(int32_t m, uint32_t *state)
     return ret / scaling;
 }
 
-int32_t Rand_div(int32_t m) { return Rand_div_impl(m, Rand_state); }
+int32_t Rand_div(int32_t m) { return Rand_div_impl(m, Rand_active); }
+
+/*
+ * Extract a "random" number from 0 to m-1 using the given RNG state
+ * (e.g. one prepared by Rand_state_split() for another thread).
+ */
+int32_t Rand_div_state(uint32_t *state, int32_t m) { return Rand_div_impl(m, state); }
+
+/*
+ * Derive every named stream from the main RNG state.
+ * Stream N starts (N + 1) * 2^64 steps ahead of Rand_state, so draws made
+ * from one stream never shift the numbers another stream produces.
+ */
+void Rand_streams_init(void)
+{
+    for (int i = 0; i < static_cast<int>(RandomStream::MAX); i++) {
+        uint32_t *state = Rand_stream_state[i];
+        for (int j = 0; j < 4; j++)
+            state[j] = (i == 0) ? Rand_state[j] : Rand_stream_state[i - 1][j];
+
+        Rand_state_jump(state);
+    }
+}
+
+/*
+ * Get the state of a named stream (for saving and loading)
+ */
+uint32_t *Rand_stream(RandomStream stream) { return Rand_stream_state[static_cast<int>(stream)]; }
+
+/*
+ * Extract a "random" number from 0 to m-1 using a named stream
+ */
+int32_t Rand_div_stream(RandomStream stream, int32_t m) { return Rand_div_impl(m, Rand_stream(stream)); }
+
+/*
+ * Make the named stream the active RNG until the scope ends
+ */
+RandomStreamScope::RandomStreamScope(RandomStream stream)
+    : previous(Rand_active)
+{
+    Rand_active = Rand_stream(stream);
+}
+
+RandomStreamScope::~RandomStreamScope() { Rand_active = this->previous; }
 
 /*
  * The number of entries in the "randnor_table"
@@ -305,6 +398,15 @@ int16_t randnor(int mean, int stand)
     return (mean + offset);
 }
 
+/*
+ * randnor() using a named stream
+ */
+int16_t randnor_stream(RandomStream stream, int mean, int stand)
+{
+    RandomStreamScope scope(stream);
+    return randnor(mean, stand);
+}
+
 /*
  * Generates damage for "2d6" style dice rolls
  */
@@ -316,6 +418,15 @@ int16_t damroll(DICE_NUMBER num, DICE_SID sides)
     return (int16_t)(sum);
 }
 
+/*
+ * damroll() using a named stream
+ */
+int16_t damroll_stream(RandomStream stream, DICE_NUMBER num, DICE_SID sides)
+{
+    RandomStreamScope scope(stream);
+    return damroll(num, sides);
+}
+
 /*
  * Same as above, but always maximal
  */
@@ -21,6 +21,20 @@
  */
 #define RAND_DEG 63
 
+/*
+ * Named RNG streams.
+ * Each subsystem draws from its own stream while a RandomStreamScope for it
+ * is active, so the number of draws one subsystem makes does not change the
+ * numbers another one gets.
+ */
+enum class RandomStream : int {
+    GENERATION = 0, /*!< Floor generation */
+    COMBAT = 1, /*!< The player's melee and missile attacks */
+    AI = 2, /*!< Monster turns */
+    STORE = 3, /*!< Store stock maintenance */
+    MAX,
+};
+
 /**** Available macros ****/
 
 /*
@@ -62,6 +76,12 @@
  */
 #define saving_throw(S) (randint0(100) < (S))
 
+/*
+ * Stream-aware forms of randint0() and randint1()
+ */
+#define randint0_stream(S, M) ((int32_t)Rand_div_stream((S), (M)))
+#define randint1_stream(S, M) (randint0_stream((S), (M)) + 1)
+
 extern uint16_t Rand_place;
 extern uint32_t Rand_state[RAND_DEG];
 
@@ -69,12 +89,35 @@ void Rand_state_init(void);
 void Rand_state_set(uint32_t seed);
 void Rand_state_backup(uint32_t *backup_state);
 void Rand_state_restore(uint32_t *backup_state);
+void Rand_state_split(uint32_t *state);
+void Rand_state_jump(uint32_t *state);
+void Rand_streams_init(void);
+uint32_t *Rand_stream(RandomStream stream);
 int32_t Rand_div(int32_t m);
+int32_t Rand_div_state(uint32_t *state, int32_t m);
+int32_t Rand_div_stream(RandomStream stream, int32_t m);
 int16_t randnor(int mean, int stand);
+int16_t randnor_stream(RandomStream stream, int mean, int stand);
 int16_t damroll(DICE_NUMBER num, DICE_SID sides);
+int16_t damroll_stream(RandomStream stream, DICE_NUMBER num, DICE_SID sides);
 int16_t maxroll(DICE_NUMBER num, DICE_SID sides);
 int32_t div_round(int32_t n, int32_t d);
 int32_t Rand_external(int32_t m);
 bool next_bool();
 
+/*
+ * Makes randint0(), damroll() and the rest draw from a named stream
+ * until the object goes out of scope.
+ */
+class RandomStreamScope {
+public:
+    explicit RandomStreamScope(RandomStream stream);
+    ~RandomStreamScope();
+    RandomStreamScope(const RandomStreamScope &) = delete;
+    RandomStreamScope &operator=(const RandomStreamScope &) = delete;
+
+private:
+    uint32_t *previous;
+};
+
 #endif
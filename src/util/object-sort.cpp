@@ -15,48 +15,46 @@
 #include "system/player-type-definition.h"
 
 /*!
- * @brief オブジェクトを定義された基準に従いソートするための関数 /
- * Check if we have space for an item in the pack without overflow
+ * @brief 価値以外の基準でオブジェクトの順序を決める
  * @param o_ptr 比較対象オブジェクトの構造体参照ポインタ1
- * @param o_value o_ptrのアイテム価値（手動であらかじめ代入する必要がある？）
  * @param j_ptr 比較対象オブジェクトの構造体参照ポインタ2
- * @return o_ptrの方が上位ならばTRUEを返す。
+ * @return o_ptrの方が上位なら1、下位なら-1、価値で決めるなら0
  */
-bool object_sort_comp(player_type *player_ptr, object_type *o_ptr, int32_t o_value, object_type *j_ptr)
+static int object_sort_order(player_type *player_ptr, object_type *o_ptr, object_type *j_ptr)
 {
     int o_type, j_type;
     if (!j_ptr->k_idx)
-        return true;
+        return 1;
 
     if ((o_ptr->tval == get_realm1_book(player_ptr)) && (j_ptr->tval != get_realm1_book(player_ptr)))
-        return true;
+        return 1;
     if ((j_ptr->tval == get_realm1_book(player_ptr)) && (o_ptr->tval != get_realm1_book(player_ptr)))
-        return false;
+        return -1;
 
     if ((o_ptr->tval == get_realm2_book(player_ptr)) && (j_ptr->tval != get_realm2_book(player_ptr)))
-        return true;
+        return 1;
     if ((j_ptr->tval == get_realm2_book(player_ptr)) && (o_ptr->tval != get_realm2_book(player_ptr)))
-        return false;
+        return -1;
 
     if (o_ptr->tval > j_ptr->tval)
-        return true;
+        return 1;
     if (o_ptr->tval < j_ptr->tval)
-        return false;
+        return -1;
 
     if (!object_is_aware(o_ptr))
-        return false;
+        return -1;
     if (!object_is_aware(j_ptr))
-        return true;
+        return 1;
 
     if (o_ptr->sval < j_ptr->sval)
-        return true;
+        return 1;
     if (o_ptr->sval > j_ptr->sval)
-        return false;
+        return -1;
 
     if (!object_is_known(o_ptr))
-        return false;
+        return -1;
     if (!object_is_known(j_ptr))
-        return true;
+        return 1;
 
     if (object_is_fixed_artifact(o_ptr))
         o_type = 3;
@@ -77,9 +75,9 @@ bool object_sort_comp(player_type *player_ptr, object_type *o_ptr, int32_t o_val
         j_type = 0;
 
     if (o_type < j_type)
-        return true;
+        return 1;
     if (o_type > j_type)
-        return false;
+        return -1;
 
     switch (o_ptr->tval) {
     case TV_FIGURINE:
@@ -87,30 +85,65 @@ bool object_sort_comp(player_type *player_ptr, object_type *o_ptr, int32_t o_val
     case TV_CORPSE:
     case TV_CAPTURE:
         if (r_info[o_ptr->pval].level < r_info[j_ptr->pval].level)
-            return true;
+            return 1;
         if ((r_info[o_ptr->pval].level == r_info[j_ptr->pval].level) && (o_ptr->pval < j_ptr->pval))
-            return true;
-        return false;
+            return 1;
+        return -1;
 
     case TV_SHOT:
     case TV_ARROW:
     case TV_BOLT:
         if (o_ptr->to_h + o_ptr->to_d < j_ptr->to_h + j_ptr->to_d)
-            return true;
+            return 1;
         if (o_ptr->to_h + o_ptr->to_d > j_ptr->to_h + j_ptr->to_d)
-            return false;
+            return -1;
         break;
 
     case TV_ROD:
         if (o_ptr->pval < j_ptr->pval)
-            return true;
+            return 1;
         if (o_ptr->pval > j_ptr->pval)
-            return false;
+            return -1;
         break;
 
     default:
         break;
     }
 
+    return 0;
+}
+
+/*!
+ * @brief オブジェクトを定義された基準に従いソートするための関数 /
+ * Check if we have space for an item in the pack without overflow
+ * @param o_ptr 比較対象オブジェクトの構造体参照ポインタ1
+ * @param o_value o_ptrのアイテム価値（手動であらかじめ代入する必要がある？）
+ * @param j_ptr 比較対象オブジェクトの構造体参照ポインタ2
+ * @return o_ptrの方が上位ならばTRUEを返す。
+ */
+bool object_sort_comp(player_type *player_ptr, object_type *o_ptr, int32_t o_value, object_type *j_ptr)
+{
+    int order = object_sort_order(player_ptr, o_ptr, j_ptr);
+    if (order != 0)
+        return order > 0;
+
     return o_value > object_value(player_ptr, j_ptr);
 }
+
+/*!
+ * @brief 両方の価値を計算済のオブジェクトを比較する / Compare objects whose values are already known
+ * @param o_ptr 比較対象オブジェクトの構造体参照ポインタ1
+ * @param o_value o_ptrのアイテム価値
+ * @param j_ptr 比較対象オブジェクトの構造体参照ポインタ2
+ * @param j_value j_ptrのアイテム価値
+ * @return o_ptrの方が上位ならばTRUEを返す。
+ * @details 並べ替えの間に同じオブジェクトの価値を何度も計算しないためのもの。
+ */
+bool object_sort_comp(player_type *player_ptr, object_type *o_ptr, int32_t o_value, object_type *j_ptr, int32_t j_value)
+{
+    int order = object_sort_order(player_ptr, o_ptr, j_ptr);
+    if (order != 0)
+        return order > 0;
+
+    return o_value > j_value;
+}
@@ -5,3 +5,4 @@
 typedef struct object_type object_type;
 typedef struct player_type player_type;
 bool object_sort_comp(player_type *player_ptr, object_type *o_ptr, int32_t o_value, object_type *j_ptr);
+bool object_sort_comp(player_type *player_ptr, object_type *o_ptr, int32_t o_value, object_type *j_ptr, int32_t j_value);
@@ -12,79 +12,19 @@
 #include "system/monster-type-definition.h"
 #include "system/player-type-definition.h"
 
-/*
- * @brief クイックソートの実行 / Quick sort in place
- * @param u アイテムやモンスター等への配列
- * @param v 条件基準IDへの参照ポインタ
- * @param a 比較対象のID1
- * @param b 比較対象のID2
- * @param ang_sort_comp 比較用の関数ポインタ
- * @param ang_sort_swap スワップ用の関数ポインタ
- */
-static void exe_ang_sort(player_type *player_ptr, vptr u, vptr v, int p, int q, bool (*ang_sort_comp)(player_type *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(player_type *, vptr, vptr, int, int))
-{
-    if (p >= q)
-        return;
-
-    int z = p;
-    int a = p;
-    int b = q;
-    while (true) {
-        /* Slide i2 */
-        while (!(*ang_sort_comp)(player_ptr, u, v, b, z))
-            b--;
-
-        /* Slide i1 */
-        while (!(*ang_sort_comp)(player_ptr, u, v, z, a))
-            a++;
-
-        if (a >= b)
-            break;
-
-        (*ang_sort_swap)(player_ptr, u, v, a, b);
-
-        a++, b--;
-    }
-
-    /* Recurse left side */
-    exe_ang_sort(player_ptr, u, v, p, b, ang_sort_comp, ang_sort_swap);
-
-    /* Recurse right side */
-    exe_ang_sort(player_ptr, u, v, b + 1, q, ang_sort_comp, ang_sort_swap);
-}
-
-/*
- * @brief クイックソートの受け付け / Accepting auick sort in place
- * @param u アイテムやモンスター等への配列
- * @param v 条件基準IDへの参照ポインタ
- * @param a 比較対象のID1
- * @param b 比較対象のID2
- * @param ang_sort_comp 比較用の関数ポインタ
- * @param ang_sort_swap スワップ用の関数ポインタ
- */
-void ang_sort(player_type *player_ptr, vptr u, vptr v, int n, bool (*ang_sort_comp)(player_type *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(player_type *, vptr, vptr, int, int))
-{
-    exe_ang_sort(player_ptr, u, v, 0, n - 1, ang_sort_comp, ang_sort_swap);
-}
-
 /*
  * Sorting hook -- comp function -- by "distance to player"
  *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by double-distance to the player.
+ * Compare two grids by double-distance to the player.
+ * Grids at the same distance are ordered by position (row-major, as they are scanned).
  */
-bool ang_sort_comp_distance(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_distance(player_type *player_ptr, POSITION ya, POSITION xa, POSITION yb, POSITION xb)
 {
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-
     /* Absolute distance components */
-    POSITION kx = x[a];
+    POSITION kx = xa;
     kx -= player_ptr->x;
     kx = ABS(kx);
-    POSITION ky = y[a];
+    POSITION ky = ya;
     ky -= player_ptr->y;
     ky = ABS(ky);
 
@@ -92,10 +32,10 @@ bool ang_sort_comp_distance(player_type *player_ptr, vptr u, vptr v, int a, int
     POSITION da = ((kx > ky) ? (kx + kx + ky) : (ky + ky + kx));
 
     /* Absolute distance components */
-    kx = x[b];
+    kx = xb;
     kx -= player_ptr->x;
     kx = ABS(kx);
-    ky = y[b];
+    ky = yb;
     ky -= player_ptr->y;
     ky = ABS(ky);
 
@@ -103,38 +43,37 @@ bool ang_sort_comp_distance(player_type *player_ptr, vptr u, vptr v, int a, int
     POSITION db = ((kx > ky) ? (kx + kx + ky) : (ky + ky + kx));
 
     /* Compare the distances */
-    return (da <= db);
+    if (da != db)
+        return da < db;
+
+    /* Compare the positions if the distances are same */
+    return (ya != yb) ? (ya < yb) : (xa < xb);
 }
 
 /*
  * Sorting hook -- comp function -- by importance level of grids
  *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by level of monster
+ * Compare two grids by level of monster
  */
-bool ang_sort_comp_importance(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_importance(player_type *player_ptr, POSITION ya, POSITION xa, POSITION yb, POSITION xb)
 {
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-    grid_type *ca_ptr = &player_ptr->current_floor_ptr->grid_array[y[a]][x[a]];
-    grid_type *cb_ptr = &player_ptr->current_floor_ptr->grid_array[y[b]][x[b]];
+    grid_type *ca_ptr = &player_ptr->current_floor_ptr->grid_array[ya][xa];
+    grid_type *cb_ptr = &player_ptr->current_floor_ptr->grid_array[yb][xb];
     monster_type *ma_ptr = &player_ptr->current_floor_ptr->m_list[ca_ptr->m_idx];
     monster_type *mb_ptr = &player_ptr->current_floor_ptr->m_list[cb_ptr->m_idx];
     monster_race *ap_ra_ptr, *ap_rb_ptr;
 
     /* The player grid */
-    if (y[a] == player_ptr->y && x[a] == player_ptr->x)
-        return true;
-
-    if (y[b] == player_ptr->y && x[b] == player_ptr->x)
-        return false;
+    bool is_player_a = (ya == player_ptr->y) && (xa == player_ptr->x);
+    bool is_player_b = (yb == player_ptr->y) && (xb == player_ptr->x);
+    if (is_player_a || is_player_b)
+        return is_player_a && !is_player_b;
 
     /* Extract monster race */
     if (ca_ptr->m_idx && ma_ptr->ml)
         ap_ra_ptr = &r_info[ma_ptr->ap_r_idx];
     else
         ap_ra_ptr = NULL;
-
     if (cb_ptr->m_idx && mb_ptr->ml)
         ap_rb_ptr = &r_info[mb_ptr->ap_r_idx];
     else
@@ -142,7 +81,6 @@ bool ang_sort_comp_importance(player_type *player_ptr, vptr u, vptr v, int a, in
 
     if (ap_ra_ptr && !ap_rb_ptr)
         return true;
-
     if (!ap_ra_ptr && ap_rb_ptr)
         return false;
 
@@ -182,67 +120,32 @@ bool ang_sort_comp_importance(player_type *player_ptr, vptr u, vptr v, int a, in
     }
 
     /* An object get higher priority */
-    if (!player_ptr->current_floor_ptr->grid_array[y[a]][x[a]].o_idx_list.empty() && player_ptr->current_floor_ptr->grid_array[y[b]][x[b]].o_idx_list.empty())
+    if (!ca_ptr->o_idx_list.empty() && cb_ptr->o_idx_list.empty())
         return true;
-
-    if (player_ptr->current_floor_ptr->grid_array[y[a]][x[a]].o_idx_list.empty() && !player_ptr->current_floor_ptr->grid_array[y[b]][x[b]].o_idx_list.empty())
+    if (ca_ptr->o_idx_list.empty() && !cb_ptr->o_idx_list.empty())
         return false;
 
     /* Priority from the terrain */
     if (f_info[ca_ptr->feat].priority > f_info[cb_ptr->feat].priority)
         return true;
-
     if (f_info[ca_ptr->feat].priority < f_info[cb_ptr->feat].priority)
         return false;
 
     /* If all conditions are same, compare distance */
-    return ang_sort_comp_distance(player_ptr, u, v, a, b);
-}
-
-/*
- * Sorting hook -- swap function -- by "distance to player"
- *
- * We use "u" and "v" to point to arrays of "x" and "y" positions,
- * and sort the arrays by distance to the player.
- */
-void ang_sort_swap_position(player_type *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-
-    POSITION *x = (POSITION *)(u);
-    POSITION *y = (POSITION *)(v);
-
-    POSITION temp = x[a];
-    x[a] = x[b];
-    x[b] = temp;
-
-    temp = y[a];
-    y[a] = y[b];
-    y[b] = temp;
+    return ang_sort_comp_distance(player_ptr, ya, xa, yb, xb);
 }
 
 /*
  * Sorting hook -- Comp function -- see below
  *
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform on "u".
+ * We use "why" to select the type of sorting to perform.
  */
-bool ang_sort_art_comp(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_art_comp(ARTIFACT_IDX w1, ARTIFACT_IDX w2, uint16_t why)
 {
-    /* Unused */
-    (void)player_ptr;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t *why = (uint16_t *)(v);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
     int z1, z2;
 
     /* Sort by total kills */
-    if (*why >= 3) {
+    if (why >= 3) {
         /* Extract total kills */
         z1 = a_info[w1].tval;
         z2 = a_info[w2].tval;
@@ -250,13 +153,12 @@ bool ang_sort_art_comp(player_type *player_ptr, vptr u, vptr v, int a, int b)
         /* Compare total kills */
         if (z1 < z2)
             return true;
-
         if (z1 > z2)
             return false;
     }
 
     /* Sort by monster level */
-    if (*why >= 2) {
+    if (why >= 2) {
         /* Extract levels */
         z1 = a_info[w1].sval;
         z2 = a_info[w2].sval;
@@ -264,13 +166,12 @@ bool ang_sort_art_comp(player_type *player_ptr, vptr u, vptr v, int a, int b)
         /* Compare levels */
         if (z1 < z2)
             return true;
-
         if (z1 > z2)
             return false;
     }
 
     /* Sort by monster experience */
-    if (*why >= 1) {
+    if (why >= 1) {
         /* Extract experience */
         z1 = a_info[w1].level;
         z2 = a_info[w2].level;
@@ -278,75 +179,35 @@ bool ang_sort_art_comp(player_type *player_ptr, vptr u, vptr v, int a, int b)
         /* Compare experience */
         if (z1 < z2)
             return true;
-
         if (z1 > z2)
             return false;
     }
 
     /* Compare indexes */
-    return (w1 <= w2);
+    return (w1 < w2);
 }
 
-/*
- * Sorting hook -- Swap function -- see below
- *
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform.
- */
-void ang_sort_art_swap(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_quest_num(QUEST_IDX q1, QUEST_IDX q2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
-}
+    quest_type *qa = &quest[q1];
+    quest_type *qb = &quest[q2];
+    if (qa->comptime != qb->comptime)
+        return qa->comptime < qb->comptime;
 
-bool ang_sort_comp_quest_num(player_type *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    QUEST_IDX *q_num = (QUEST_IDX *)u;
-    quest_type *qa = &quest[q_num[a]];
-    quest_type *qb = &quest[q_num[b]];
-    return (qa->comptime != qb->comptime) ? (qa->comptime < qb->comptime) : (qa->level <= qb->level);
-}
+    if (qa->level != qb->level)
+        return qa->level < qb->level;
 
-void ang_sort_swap_quest_num(player_type *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    QUEST_IDX *q_num = (QUEST_IDX *)u;
-    QUEST_IDX tmp = q_num[a];
-    q_num[a] = q_num[b];
-    q_num[b] = tmp;
+    return q1 < q2;
 }
 
 /*!
  * @brief ペット入りモンスターボールをソートするための比較関数
- * @param u 所持品配列の参照ポインタ
- * @param v 未使用
- * @param a 所持品ID1
- * @param b 所持品ID2
+ * @param w1 モンスターID1
+ * @param w2 モンスターID2
  * @return 1の方が大であればTRUE
  */
-bool ang_sort_comp_pet(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_pet(player_type *player_ptr, MONSTER_IDX w1, MONSTER_IDX w2)
 {
-    /* Unused */
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
     monster_type *m_ptr1 = &player_ptr->current_floor_ptr->m_list[w1];
     monster_type *m_ptr2 = &player_ptr->current_floor_ptr->m_list[w2];
     monster_race *r_ptr1 = &r_info[m_ptr1->r_idx];
@@ -376,35 +237,23 @@ bool ang_sort_comp_pet(player_type *player_ptr, vptr u, vptr v, int a, int b)
     if (m_ptr2->hp > m_ptr1->hp)
         return false;
 
-    return w1 <= w2;
+    return w1 < w2;
 }
 
 /*!
  * @brief モンスター種族情報を特定の基準によりソートするための比較処理
  * Sorting hook -- Comp function -- see below
- * @param u モンスター種族情報の入れるポインタ
- * @param v 条件基準ID
- * @param a 比較するモンスター種族のID1
- * @param b 比較するモンスター種族のID2
+ * @param w1 比較するモンスター種族のID1
+ * @param w2 比較するモンスター種族のID2
+ * @param why 条件基準ID
  * @return 2の方が大きければTRUEを返す
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform on "u".
  */
-bool ang_sort_comp_hook(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_hook(MONRACE_IDX w1, MONRACE_IDX w2, uint16_t why)
 {
-    /* Unused */
-    (void)player_ptr;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t *why = (uint16_t *)(v);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
     int z1, z2;
 
     /* Sort by player kills */
-    if (*why >= 4) {
+    if (why >= 4) {
         /* Extract player kills */
         z1 = r_info[w1].r_pkills;
         z2 = r_info[w2].r_pkills;
@@ -417,7 +266,7 @@ bool ang_sort_comp_hook(player_type *player_ptr, vptr u, vptr v, int a, int b)
     }
 
     /* Sort by total kills */
-    if (*why >= 3) {
+    if (why >= 3) {
         /* Extract total kills */
         z1 = r_info[w1].r_tkills;
         z2 = r_info[w2].r_tkills;
@@ -430,7 +279,7 @@ bool ang_sort_comp_hook(player_type *player_ptr, vptr u, vptr v, int a, int b)
     }
 
     /* Sort by monster level */
-    if (*why >= 2) {
+    if (why >= 2) {
         /* Extract levels */
         z1 = r_info[w1].level;
         z2 = r_info[w2].level;
@@ -443,7 +292,7 @@ bool ang_sort_comp_hook(player_type *player_ptr, vptr u, vptr v, int a, int b)
     }
 
     /* Sort by monster experience */
-    if (*why >= 1) {
+    if (why >= 1) {
         /* Extract experience */
         z1 = r_info[w1].mexp;
         z2 = r_info[w2].mexp;
@@ -456,48 +305,14 @@ bool ang_sort_comp_hook(player_type *player_ptr, vptr u, vptr v, int a, int b)
     }
 
     /* Compare indexes */
-    return (w1 <= w2);
-}
-
-/*!
- * @brief モンスター種族情報を特定の基準によりソートするためのスワップ処理
- * Sorting hook -- Swap function -- see below
- * @param u モンスター種族情報の入れるポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- * @details
- * We use "u" to point to array of monster indexes,
- * and "v" to select the type of sorting to perform.
- */
-void ang_sort_swap_hook(player_type *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-    uint16_t holder;
-
-    holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
+    return (w1 < w2);
 }
 
 /*
  * hook function to sort monsters by level
  */
-bool ang_sort_comp_monster_level(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_monster_level(MONRACE_IDX w1, MONRACE_IDX w2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
     monster_race *r_ptr1 = &r_info[w1];
     monster_race *r_ptr2 = &r_info[w2];
 
@@ -513,27 +328,17 @@ bool ang_sort_comp_monster_level(player_type *player_ptr, vptr u, vptr v, int a,
     if ((r_ptr1->flags1 & RF1_UNIQUE) && !(r_ptr2->flags1 & RF1_UNIQUE))
         return false;
 
-    return w1 <= w2;
+    return w1 < w2;
 }
 
 /*!
  * @brief ペットになっているモンスターをソートするための比較処理
- * @param u モンスターの構造体配列
- * @param v 未使用
- * @param a 比較対象のモンスターID1
- * @param b 比較対象のモンスターID2
+ * @param w1 比較対象のモンスターID1
+ * @param w2 比較対象のモンスターID2
  * @return 2番目が大ならばTRUEを返す
  */
-bool ang_sort_comp_pet_dismiss(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_pet_dismiss(player_type *player_ptr, MONSTER_IDX w1, MONSTER_IDX w2)
 {
-    /* Unused */
-    (void)v;
-
-    uint16_t *who = (uint16_t *)(u);
-
-    int w1 = who[a];
-    int w2 = who[b];
-
     monster_type *m_ptr1 = &player_ptr->current_floor_ptr->m_list[w1];
     monster_type *m_ptr2 = &player_ptr->current_floor_ptr->m_list[w2];
     monster_race *r_ptr1 = &r_info[m_ptr1->r_idx];
@@ -575,71 +380,44 @@ bool ang_sort_comp_pet_dismiss(player_type *player_ptr, vptr u, vptr v, int a, i
     if (m_ptr2->hp > m_ptr1->hp)
         return false;
 
-    return w1 <= w2;
+    return w1 < w2;
 }
 
 /*!
  * @brief フロア保存時のgrid情報テンプレートをソートするための比較処理
- * @param u gridテンプレートの参照ポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- * @return aの方が大きければtrue
+ * @param template1 比較するgridテンプレート1
+ * @param template2 比較するgridテンプレート2
+ * @return 1の方が多く使われていればtrue (同数ならば内容で比較する)
  */
-bool ang_sort_comp_cave_temp(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_cave_temp(const grid_template_type &template1, const grid_template_type &template2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    grid_template_type *who = (grid_template_type *)(u);
+    if (template1.occurrence != template2.occurrence)
+        return template2.occurrence < template1.occurrence;
 
-    uint16_t o1 = who[a].occurrence;
-    uint16_t o2 = who[b].occurrence;
+    /* 使用回数が同じなら内容で順序を決め、保存のたびに並びが変わらないようにする */
+    if (template1.feat != template2.feat)
+        return template1.feat < template2.feat;
 
-    return o2 <= o1;
-}
-
-/*!
- * @brief フロア保存時のgrid情報テンプレートをソートするためのスワップ処理 / Sorting hook -- Swap function
- * @param u gridテンプレートの参照ポインタ
- * @param v 未使用
- * @param a スワップするモンスター種族のID1
- * @param b スワップするモンスター種族のID2
- */
-void ang_sort_swap_cave_temp(player_type *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
+    if (template1.mimic != template2.mimic)
+        return template1.mimic < template2.mimic;
 
-    grid_template_type *who = (grid_template_type *)(u);
-    grid_template_type holder;
+    if (template1.info != template2.info)
+        return template1.info < template2.info;
 
-    holder = who[a];
-    who[a] = who[b];
-    who[b] = holder;
+    return template1.special < template2.special;
 }
 
 /*!
  * @brief 進化ツリーをソートするためモンスター種族の判定関数 /
  * Sorting hook -- Comp function
- * @param u 進化木構造データ
- * @param v 未使用
- * @param a 比較したいモンスター種族ID1
- * @param b 比較したいモンスター種族ID2
+ * @param tree1 比較したい進化木構造1
+ * @param tree2 比較したい進化木構造2
  * @return 2が大きければTRUEを返す
  */
-bool ang_sort_comp_evol_tree(player_type *player_ptr, vptr u, vptr v, int a, int b)
+bool ang_sort_comp_evol_tree(const int *tree1, const int *tree2)
 {
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    int **evol_tree = (int **)u;
-
-    int w1 = evol_tree[a][0];
-    int w2 = evol_tree[b][0];
+    int w1 = tree1[0];
+    int w2 = tree2[0];
     monster_race *r1_ptr = &r_info[w1];
     monster_race *r2_ptr = &r_info[w2];
 
@@ -665,28 +443,5 @@ bool ang_sort_comp_evol_tree(player_type *player_ptr, vptr u, vptr v, int a, int
         return false;
 
     /* Compare indexes */
-    return w1 <= w2;
-}
-
-/*!
- * @brief 進化ツリーをソートするため木構造のスワップ関数 /
- * Sorting hook -- Swap function
- * @param u 進化木構造データ
- * @param v 未使用
- * @param a スワップしたい木構造1
- * @param b スワップしたい木構造2
- * @return 2が大きければTRUEを返す
- */
-void ang_sort_swap_evol_tree(player_type *player_ptr, vptr u, vptr v, int a, int b)
-{
-    /* Unused */
-    (void)player_ptr;
-    (void)v;
-
-    int **evol_tree = (int **)u;
-    int *holder;
-
-    holder = evol_tree[a];
-    evol_tree[a] = evol_tree[b];
-    evol_tree[b] = holder;
+    return w1 < w2;
 }
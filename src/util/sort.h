@@ -1,31 +1,154 @@
-﻿#pragma once
+#pragma once
 
 #include "system/angband.h"
 
 #include "system/player-type-definition.h"
-void ang_sort(player_type *player_ptr, vptr u, vptr v, int n, bool (*ang_sort_comp)(player_type *, vptr, vptr, int, int),
-    void (*ang_sort_swap)(player_type *, vptr, vptr, int, int));
+#include <utility>
 
-bool ang_sort_comp_distance(player_type *player_ptr, vptr u, vptr v, int a, int b);
-bool ang_sort_comp_importance(player_type *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_position(player_type *player_ptr, vptr u, vptr v, int a, int b);
+namespace ang_sort_detail {
+constexpr int INSERTION_SORT_THRESHOLD = 16; //!< この要素数以下の区間は挿入ソートで片付ける
 
-bool ang_sort_art_comp(player_type *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_art_swap(player_type *player_ptr, vptr u, vptr v, int a, int b);
+template <typename Compare, typename Swap>
+void insertion_sort(int first, int last, Compare &comp, Swap &swap)
+{
+    for (int i = first + 1; i < last; i++)
+        for (int j = i; (j > first) && comp(j, j - 1); j--)
+            swap(j, j - 1);
+}
 
-bool ang_sort_comp_quest_num(player_type *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_quest_num(player_type *player_ptr, vptr u, vptr v, int a, int b);
+template <typename Compare, typename Swap>
+void sift_down(int first, int root, int n, Compare &comp, Swap &swap)
+{
+    while (true) {
+        int child = root * 2 + 1;
+        if (child >= n)
+            return;
 
-bool ang_sort_comp_pet(player_type *player_ptr, vptr u, vptr v, int a, int b);
+        if ((child + 1 < n) && comp(first + child, first + child + 1))
+            child++;
 
-bool ang_sort_comp_hook(player_type *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_hook(player_type *player_ptr, vptr u, vptr v, int a, int b);
+        if (!comp(first + root, first + child))
+            return;
 
-bool ang_sort_comp_monster_level(player_type *player_ptr, vptr u, vptr v, int a, int b);
-bool ang_sort_comp_pet_dismiss(player_type *player_ptr, vptr u, vptr v, int a, int b);
+        swap(first + root, first + child);
+        root = child;
+    }
+}
 
-bool ang_sort_comp_cave_temp(player_type *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_cave_temp(player_type *player_ptr, vptr u, vptr v, int a, int b);
+template <typename Compare, typename Swap>
+void heap_sort(int first, int last, Compare &comp, Swap &swap)
+{
+    int n = last - first;
+    for (int i = n / 2 - 1; i >= 0; i--)
+        sift_down(first, i, n, comp, swap);
 
-bool ang_sort_comp_evol_tree(player_type *player_ptr, vptr u, vptr v, int a, int b);
-void ang_sort_swap_evol_tree(player_type *player_ptr, vptr u, vptr v, int a, int b);
+    for (int end = n - 1; end > 0; end--) {
+        swap(first, first + end);
+        sift_down(first, 0, end, comp, swap);
+    }
+}
+
+/*
+ * 先頭・中央・末尾の中央値を先頭に置いて軸とし、区間を分割する。
+ * 軸と等しい要素では左右どちらの走査も止まるため、同値が多くても分割は偏らない。
+ */
+template <typename Compare, typename Swap>
+int partition(int first, int last, Compare &comp, Swap &swap)
+{
+    int mid = first + (last - first) / 2;
+    if (comp(mid, first))
+        swap(mid, first);
+    if (comp(last - 1, mid)) {
+        swap(last - 1, mid);
+        if (comp(mid, first))
+            swap(mid, first);
+    }
+
+    swap(first, mid);
+    int i = first + 1;
+    int j = last - 1;
+    while (true) {
+        while ((i <= j) && comp(i, first))
+            i++;
+        while ((i <= j) && comp(first, j))
+            j--;
+        if (i >= j)
+            break;
+
+        swap(i, j);
+        i++;
+        j--;
+    }
+
+    swap(first, j);
+    return j;
+}
+
+template <typename Compare, typename Swap>
+void introsort(int first, int last, int depth, Compare &comp, Swap &swap)
+{
+    while (last - first > INSERTION_SORT_THRESHOLD) {
+        if (depth == 0) {
+            heap_sort(first, last, comp, swap);
+            return;
+        }
+
+        depth--;
+        int pivot = partition(first, last, comp, swap);
+        if (pivot - first < last - pivot - 1) {
+            introsort(first, pivot, depth, comp, swap);
+            first = pivot + 1;
+        } else {
+            introsort(pivot + 1, last, depth, comp, swap);
+            last = pivot;
+        }
+    }
+
+    insertion_sort(first, last, comp, swap);
+}
+}
+
+/*!
+ * @brief 添字で比較・交換するイントロソート / Introsort driven by index callbacks
+ * @param n 要素数
+ * @param comp 添字aの要素が添字bの要素より前に来るべきならtrueを返す関数オブジェクト (狭義の弱順序)
+ * @param swap 添字aとbの要素を入れ替える関数オブジェクト
+ * @details
+ * 座標のように複数の配列を並行して並べ替える呼び出し元向け。
+ * クイックソートの再帰が深くなりすぎたらヒープソートに切り替えるため、最悪でも O(n log n) で終わる。
+ * 安定ソートではない。
+ */
+template <typename Compare, typename Swap>
+void ang_sort(int n, Compare comp, Swap swap)
+{
+    int depth = 0;
+    for (int i = n; i > 1; i >>= 1)
+        depth += 2;
+
+    ang_sort_detail::introsort(0, n, depth, comp, swap);
+}
+
+/*!
+ * @brief 配列を要素の比較で並べ替える / Sort an array in place with a typed comparator
+ * @param array 並べ替える配列
+ * @param n 要素数
+ * @param comp 要素aが要素bより前に来るべきならtrueを返す関数オブジェクト (狭義の弱順序)
+ */
+template <typename T, typename Compare>
+void ang_sort(T *array, int n, Compare comp)
+{
+    ang_sort(
+        n, [array, &comp](int a, int b) { return comp(array[a], array[b]); }, [array](int a, int b) { std::swap(array[a], array[b]); });
+}
+
+struct grid_template_type;
+bool ang_sort_comp_distance(player_type *player_ptr, POSITION ya, POSITION xa, POSITION yb, POSITION xb);
+bool ang_sort_comp_importance(player_type *player_ptr, POSITION ya, POSITION xa, POSITION yb, POSITION xb);
+bool ang_sort_art_comp(ARTIFACT_IDX w1, ARTIFACT_IDX w2, uint16_t why);
+bool ang_sort_comp_quest_num(QUEST_IDX q1, QUEST_IDX q2);
+bool ang_sort_comp_pet(player_type *player_ptr, MONSTER_IDX w1, MONSTER_IDX w2);
+bool ang_sort_comp_hook(MONRACE_IDX w1, MONRACE_IDX w2, uint16_t why);
+bool ang_sort_comp_monster_level(MONRACE_IDX w1, MONRACE_IDX w2);
+bool ang_sort_comp_pet_dismiss(player_type *player_ptr, MONSTER_IDX w1, MONSTER_IDX w2);
+bool ang_sort_comp_cave_temp(const grid_template_type &template1, const grid_template_type &template2);
+bool ang_sort_comp_evol_tree(const int *tree1, const int *tree2);
@@ -24,6 +24,10 @@
 #include "util/bit-flags-calculator.h"
 #include "window/main-window-util.h"
 #include "world/world.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
 
 byte display_autopick; /*!< 自動拾い状態の設定フラグ */
 
@@ -371,3 +375,283 @@ void map_info(player_type *player_ptr, POSITION y, POSITION x, TERM_COLOR *ap, S
     *cp = c;
     set_term_color(player_ptr, y, x, ap, cp);
 }
+
+namespace {
+/*!
+ * @brief map_info() の結果を1グリッド分保持する / Cached map_info() result of a grid
+ */
+struct map_info_cache_entry {
+    bool valid{}; //!< 保持している結果が使えるか (偽ならば dirty)
+    TERM_COLOR a{}; //!< 文字色属性
+    SYMBOL_CODE c{}; //!< 文字種属性
+    TERM_COLOR ta{}; //!< 文字色属性(タイル)
+    SYMBOL_CODE tc{}; //!< 文字種属性(タイル)
+    int priority{}; //!< feat_priority を -1 として呼んだ時の結果
+    int match{}; //!< match_autopick を -1 として呼んだ時の結果
+    object_type *autopick_object{}; //!< autopick_obj を NULL として呼んだ時の結果
+};
+
+using map_info_cache_key = std::array<int, 18>;
+
+/*!
+ * @brief map_info() の結果のキャッシュ / Per-floor cache of map_info() results
+ * @details
+ * グリッドの状態が変わった時には lite_spot() か note_spot() が呼ばれるため、そこで周囲のグリッドを dirty にする。
+ * 盲目や表示オプションのように全グリッドに効く状態は key に持ち、変わったら全て捨てる。
+ * 全体の再描画 (print_map()) も何が変わったかわからない時の合図なので全て捨てる。
+ */
+struct map_info_cache_type {
+    map_info_cache_key key{}; //!< 結果を作った時の階と表示状態
+    POSITION height{}; //!< 階の縦幅
+    POSITION width{}; //!< 階の横幅
+    std::vector<map_info_cache_entry> entries; //!< 各グリッドの結果
+    uint32_t last_used{}; //!< 最後に使った時の通し番号
+    uint32_t generation{}; //!< 空にして作り直した時の通し番号
+};
+
+/*!
+ * @brief 表示状態毎のキャッシュ
+ * @details 縮小マップ (display_map()) は一部の表示オプションを切って map_info() を呼ぶため、メインマップとは別に持つ。
+ */
+std::array<map_info_cache_type, 2> map_info_caches;
+uint32_t map_info_cache_clock = 0;
+
+constexpr size_t MAP_CHANGE_LOG_MAX = 4096; //!< 変化したグリッドの記録の上限。超えたら読み手には全体を描き直させる
+
+uint32_t map_info_generation = 0; //!< キャッシュを作り直す度に増える通し番号
+std::vector<map_grid_pos> map_change_log; //!< invalidate_map_info_cache() で通知されたグリッドの記録
+uint64_t map_change_log_base = 0; //!< map_change_log の先頭の通し番号
+}
+
+/*!
+ * @brief 表示状態に合うキャッシュを返す。なければ最も長く使っていないものを空にして返す
+ * @param floor_ptr 階の情報への参照ポインタ
+ * @param key 現在の階と表示状態
+ * @return キャッシュへの参照
+ */
+static map_info_cache_type &get_map_info_cache(floor_type *floor_ptr, const map_info_cache_key &key)
+{
+    map_info_cache_type *found = nullptr;
+    for (auto &cache : map_info_caches) {
+        if (!cache.entries.empty() && (cache.key == key)) {
+            found = &cache;
+            break;
+        }
+    }
+
+    if (found == nullptr) {
+        found = &map_info_caches[0];
+        for (auto &cache : map_info_caches) {
+            if (cache.last_used < found->last_used)
+                found = &cache;
+        }
+
+        found->key = key;
+        found->generation = ++map_info_generation;
+        found->height = floor_ptr->height;
+        found->width = floor_ptr->width;
+        found->entries.assign(found->height * found->width, map_info_cache_entry());
+    }
+
+    found->last_used = ++map_info_cache_clock;
+    return *found;
+}
+
+/*!
+ * @brief 全グリッドの表示に影響する階と表示状態の一覧を返す
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @return 状態の一覧
+ */
+static map_info_cache_key get_map_info_cache_key(player_type *player_ptr)
+{
+    floor_type *floor_ptr = player_ptr->current_floor_ptr;
+    return { {
+        floor_ptr->dun_level,
+        floor_ptr->inside_quest,
+        floor_ptr->height,
+        floor_ptr->width,
+        floor_ptr->dungeon_idx,
+        player_ptr->blind != 0,
+        player_ptr->see_nocto != 0,
+        player_ptr->wild_mode,
+        player_ptr->wild_mode && is_daytime(),
+        display_autopick,
+        use_graphics,
+        view_special_lite,
+        view_yellow_lite,
+        view_bright_lite,
+        view_granite_lite,
+        view_hidden_walls,
+        view_unsafe_walls,
+        view_unsafe_grids,
+    } };
+}
+
+/*!
+ * @brief map_info() の結果が乱数によらず決まるかを返す
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param y 階の中のy座標
+ * @param x 階の中のx座標
+ * @return 同じ状態ならば常に同じ結果となるならばtrue
+ * @details
+ * プレイヤー自身の表示は r_info[0] をその都度参照するためキャッシュしない。
+ * 視界内の壁は check_local_illumination() によりプレイヤーの位置で明るさが変わりうるためキャッシュしない。
+ */
+bool is_map_info_cacheable(player_type *player_ptr, POSITION y, POSITION x)
+{
+    if (player_bold(player_ptr, y, x))
+        return false;
+
+    floor_type *floor_ptr = player_ptr->current_floor_ptr;
+    grid_type *g_ptr = &floor_ptr->grid_array[y][x];
+    if (view_granite_lite && view_bright_lite && g_ptr->is_view()) {
+        feature_type *f_ptr = &f_info[g_ptr->get_feat_mimic()];
+        if (f_ptr->flags.has(FF::REMEMBER) && f_ptr->flags.has_not(FF::LOS))
+            return false;
+    }
+
+    if (g_ptr->m_idx == 0)
+        return true;
+
+    monster_type *m_ptr = &floor_ptr->m_list[g_ptr->m_idx];
+    if (!m_ptr->ml)
+        return true;
+
+    return none_bits(r_info[m_ptr->ap_r_idx].flags1, RF1_ATTR_MULTI | RF1_SHAPECHANGER);
+}
+
+/*!
+ * @brief キャッシュを通して地形の表示属性を取得する / Extract the attr/char of a grid through the per-floor cache
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param y 階の中のy座標
+ * @param x 階の中のx座標
+ * @param ap 文字色属性
+ * @param cp 文字種属性
+ * @param tap 文字色属性(タイル)
+ * @param tcp 文字種属性(タイル)
+ * @details
+ * feat_priority・match_autopick・autopick_obj は、それぞれ -1・-1・NULL にしてから map_info() を呼んだ時と同じ値になる。
+ * CHECK_MAP_INFO_CACHE を定義すると、キャッシュの結果をその都度 map_info() と突き合わせる。
+ */
+void map_info_cached(player_type *player_ptr, POSITION y, POSITION x, TERM_COLOR *ap, SYMBOL_CODE *cp, TERM_COLOR *tap, SYMBOL_CODE *tcp)
+{
+    feat_priority = -1;
+    match_autopick = -1;
+    autopick_obj = NULL;
+    if (player_ptr->image) {
+        map_info(player_ptr, y, x, ap, cp, tap, tcp);
+        return;
+    }
+
+    auto &cache = get_map_info_cache(player_ptr->current_floor_ptr, get_map_info_cache_key(player_ptr));
+    auto &entry = cache.entries[y * cache.width + x];
+    if (!entry.valid) {
+        TERM_COLOR a, ta;
+        SYMBOL_CODE c, tc;
+        map_info(player_ptr, y, x, &a, &c, &ta, &tc);
+        if (!is_map_info_cacheable(player_ptr, y, x)) {
+            *tap = ta;
+            *tcp = tc;
+            *ap = a;
+            *cp = c;
+            return;
+        }
+
+        entry.a = a;
+        entry.c = c;
+        entry.ta = ta;
+        entry.tc = tc;
+        entry.priority = feat_priority;
+        entry.match = match_autopick;
+        entry.autopick_object = autopick_obj;
+        entry.valid = true;
+    }
+#ifdef CHECK_MAP_INFO_CACHE
+    else {
+        TERM_COLOR a, ta;
+        SYMBOL_CODE c, tc;
+        map_info(player_ptr, y, x, &a, &c, &ta, &tc);
+        assert((a == entry.a) && (c == entry.c) && (ta == entry.ta) && (tc == entry.tc));
+        assert((feat_priority == entry.priority) && (match_autopick == entry.match) && (autopick_obj == entry.autopick_object));
+    }
+#endif
+
+    feat_priority = entry.priority;
+    match_autopick = entry.match;
+    autopick_obj = entry.autopick_object;
+    *tap = entry.ta;
+    *tcp = entry.tc;
+    *ap = entry.a;
+    *cp = entry.c;
+}
+
+/*!
+ * @brief グリッドの状態が変わったことをキャッシュに通知する / Mark a grid and its neighbors as dirty
+ * @param floor_ptr 階の情報への参照ポインタ
+ * @param y 階の中のy座標
+ * @param x 階の中のx座標
+ * @details 壁の表示は周囲の地形や明るさにもよるため、周囲8グリッドも dirty にする。
+ */
+void invalidate_map_info_cache(floor_type *floor_ptr, POSITION y, POSITION x)
+{
+    if (map_change_log.size() >= MAP_CHANGE_LOG_MAX) {
+        map_change_log_base += map_change_log.size();
+        map_change_log.clear();
+    }
+
+    map_change_log.push_back({ y, x });
+    for (auto &cache : map_info_caches) {
+        if (cache.entries.empty() || (cache.height != floor_ptr->height) || (cache.width != floor_ptr->width))
+            continue;
+
+        for (POSITION yy = std::max(y - 1, 0); yy <= std::min(y + 1, cache.height - 1); yy++)
+            for (POSITION xx = std::max(x - 1, 0); xx <= std::min(x + 1, cache.width - 1); xx++)
+                cache.entries[yy * cache.width + xx].valid = false;
+    }
+}
+
+/*!
+ * @brief キャッシュを全て捨てる / Discard every cached map_info() result
+ */
+void clear_map_info_cache(void)
+{
+    for (auto &cache : map_info_caches)
+        cache.entries.clear();
+}
+
+/*!
+ * @brief 現在の表示状態のキャッシュの世代を返す / Return the generation of the cache for the current display state
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @return キャッシュを作り直す度に変わる通し番号
+ * @details
+ * 前回の描画時と異なれば、表示状態が変わったかキャッシュが捨てられたので、
+ * 変化したグリッドの記録に関わらず全体を描き直す必要がある。
+ */
+uint32_t get_map_info_generation(player_type *player_ptr)
+{
+    return get_map_info_cache(player_ptr->current_floor_ptr, get_map_info_cache_key(player_ptr)).generation;
+}
+
+/*!
+ * @brief 変化したグリッドの記録の現在の末尾を返す / Return the current end of the changed-grid log
+ * @return 通し番号
+ */
+uint64_t get_map_change_serial(void)
+{
+    return map_change_log_base + map_change_log.size();
+}
+
+/*!
+ * @brief 指定の通し番号以降に変化したグリッドを返す / Collect the grids noted since a log position
+ * @param serial get_map_change_serial() で得た通し番号
+ * @param grids 変化したグリッドの追加先。周囲8グリッドも表示が変わりうる点に注意
+ * @return 記録が既に捨てられていればfalse (全体を描き直す必要がある)
+ */
+bool get_map_changes_since(uint64_t serial, std::vector<map_grid_pos> &grids)
+{
+    if (serial < map_change_log_base)
+        return false;
+
+    grids.insert(grids.end(), map_change_log.begin() + (serial - map_change_log_base), map_change_log.end());
+    return true;
+}
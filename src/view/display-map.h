@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "system/angband.h"
+#include <vector>
 
 #define MAX_IMAGE_OBJECT_HACK 19
 #define MAX_IMAGE_MONSTER_HACK 53
@@ -9,5 +10,21 @@ extern byte display_autopick;
 extern char image_object_hack[MAX_IMAGE_OBJECT_HACK];
 extern char image_monster_hack[MAX_IMAGE_MONSTER_HACK];
 
+/*!
+ * @brief 階の中の座標 / A grid position in the floor
+ */
+struct map_grid_pos {
+    POSITION y;
+    POSITION x;
+};
+
+typedef struct floor_type floor_type;
 typedef struct player_type player_type;
 void map_info(player_type *player_ptr, POSITION y, POSITION x, TERM_COLOR *ap, SYMBOL_CODE *cp, TERM_COLOR *tap, SYMBOL_CODE *tcp);
+void map_info_cached(player_type *player_ptr, POSITION y, POSITION x, TERM_COLOR *ap, SYMBOL_CODE *cp, TERM_COLOR *tap, SYMBOL_CODE *tcp);
+void invalidate_map_info_cache(floor_type *floor_ptr, POSITION y, POSITION x);
+void clear_map_info_cache(void);
+bool is_map_info_cacheable(player_type *player_ptr, POSITION y, POSITION x);
+uint32_t get_map_info_generation(player_type *player_ptr);
+uint64_t get_map_change_serial(void);
+bool get_map_changes_since(uint64_t serial, std::vector<map_grid_pos> &grids);
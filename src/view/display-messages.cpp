@@ -12,10 +12,11 @@
 #include "util/int-char-converter.h"
 #include "world/world.h"
 
-#include <deque>
-#include <map>
+#include <algorithm>
+#include <cstring>
 #include <memory>
-#include <string>
+#include <new>
+#include <string_view>
 
 /* Used in msg_print() for "buffering" */
 bool msg_flag;
@@ -23,42 +24,354 @@ bool msg_flag;
 COMMAND_CODE now_message;
 
 namespace {
-using msg_sp = std::shared_ptr<const std::string>;
-using msg_wp = std::weak_ptr<const std::string>;
+/** メッセージ本文を格納するアリーナのバイト数 */
+constexpr uint32_t MESSAGE_BUF = 16777216;
 
-/** メッセージが同一かどうかを比較するためのラムダ式 */
-auto string_ptr_cmp = [](const std::string *a, const std::string *b) { return *a < *b; };
+/** 本文の最大長 (message_add_aux() の作業領域の大きさから終端の分を除いたもの) */
+constexpr uint32_t MESSAGE_LENGTH_MAX = 127;
 
-/** 同一メッセージの検索に使用するmapオブジェクト。
- * 同一メッセージがあるかどうかを検索し、ヒットしたらweak_ptrからshared_ptrを作成しメッセージを共有する。
- * message_historyのカスタムデリータの中で参照するので、message_historyより先に宣言しなければならない事に注意。
+/** 本文ブロックの数の上限 (追加中のメッセージの分だけMESSAGE_MAXより多い) */
+constexpr uint32_t MESSAGE_TEXT_MAX = MESSAGE_MAX + 1;
+
+/** 同一メッセージ検索用ハッシュ表の大きさ (2の累乗、MESSAGE_TEXT_MAXの2倍以上) */
+constexpr uint32_t MESSAGE_INDEX_SIZE = 262144;
+
+/** 未使用のブロック番号・ハッシュ表の空きスロット */
+constexpr uint32_t MESSAGE_TEXT_NONE = 0xFFFFFFFF;
+
+/** ハッシュ表の削除済スロット */
+constexpr uint32_t MESSAGE_INDEX_DELETED = 0xFFFFFFFE;
+
+/**
+ * @brief アリーナ上のブロックの先頭に置くヘッダ
+ * @details 本文はヘッダの直後にヌル終端で格納し、ブロック全体はヘッダの大きさの倍数に切り上げる。
  */
-std::map<const std::string *, msg_wp, decltype(string_ptr_cmp)> message_map(string_ptr_cmp);
+struct message_block_header {
+    uint32_t text_id; //!< 本文の番号 (参照されなくなった本文やアリーナ末尾の詰め物ならばMESSAGE_TEXT_NONE)
+    uint32_t size; //!< ヘッダを含むブロック全体のバイト数
+};
+
+/** ブロックの最大のバイト数 */
+constexpr uint32_t MESSAGE_BLOCK_MAX = (sizeof(message_block_header) + MESSAGE_LENGTH_MAX + 1 + sizeof(message_block_header) - 1) / sizeof(message_block_header) * sizeof(message_block_header);
 
-/** メッセージ履歴 */
-std::deque<msg_sp> message_history;
+/* 全ての本文が最長でも、折り返しの詰め物と追加中のブロックの分を除いて全てアリーナに収まること */
+static_assert(MESSAGE_TEXT_MAX * MESSAGE_BLOCK_MAX + MESSAGE_BLOCK_MAX * 2 <= MESSAGE_BUF);
 
 /**
- * @brief メッセージを保持する msg_sp オブジェクトを生成する
- *
- * @tparam T メッセージの型。std::string / std::string_view / const char* 等
- * @param str メッセージ
- * @return 生成した msg_sp オブジェクト
+ * @brief 本文の管理情報
+ */
+struct message_text_type {
+    uint32_t offset; //!< アリーナ上のブロックの位置
+    uint32_t refcount; //!< この本文を参照しているメッセージ履歴の数
+    uint32_t hash; //!< 本文のハッシュ値
+    uint32_t length; //!< 本文の長さ
+};
+
+/**
+ * @brief メッセージ履歴
+ * @details
+ * 本文は固定長のアリーナにリングバッファとして詰めて格納し、履歴は本文の番号を固定長のリングバッファで保持する。
+ * 同一の本文は複数の履歴で共有し、ハッシュ表で検索する。
+ * アリーナが一杯になったら最も古いブロックから解放し、まだ参照されている本文は先頭へ移し替える。
+ * アリーナは全ての履歴が最長の本文でも収まる大きさなので、履歴はMESSAGE_MAX - 1件まで保持される。
+ * これらの領域は最初のメッセージ追加時に一度だけ確保する。
+ */
+struct message_history_type {
+    std::unique_ptr<char[]> arena; //!< 本文のアリーナ
+    uint32_t arena_head{}; //!< 次にブロックを書き込む位置
+    uint32_t arena_tail{}; //!< 最も古いブロックの位置
+    uint32_t arena_used{}; //!< 使用中のバイト数
+    uint32_t arena_live{}; //!< 参照中の本文が占めるバイト数
+
+    std::unique_ptr<message_text_type[]> texts; //!< 本文の管理情報
+    std::unique_ptr<uint32_t[]> free_texts; //!< 未使用の本文番号のスタック
+    uint32_t free_text_num{}; //!< 未使用の本文番号の数
+
+    std::unique_ptr<uint32_t[]> entries; //!< 各履歴の本文番号
+    uint32_t entry_head{}; //!< 次に履歴を書き込む位置
+    uint32_t entry_num{}; //!< 履歴の数
+
+    std::unique_ptr<uint32_t[]> index; //!< 本文番号のハッシュ表 (参照中の本文のみ)
+    uint32_t index_used{}; //!< 使用中と削除済のスロット数
+
+    message_history_stats_type stats{}; //!< 統計情報
+};
+
+message_history_type message_history;
+
+/**
+ * @brief メッセージ本文のハッシュ値を求める (FNV-1a)
+ * @param str メッセージ本文
+ * @return ハッシュ値
+ */
+uint32_t hash_message(std::string_view str)
+{
+    uint32_t hash = 2166136261U;
+    for (const auto c : str) {
+        hash ^= static_cast<byte>(c);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+message_block_header *get_message_block(uint32_t offset)
+{
+    return reinterpret_cast<message_block_header *>(&message_history.arena[offset]);
+}
+
+const char *get_message_text(uint32_t text_id)
+{
+    return &message_history.arena[message_history.texts[text_id].offset + sizeof(message_block_header)];
+}
+
+/**
+ * @brief 同一の本文を探す
+ * @param str メッセージ本文
+ * @param hash 本文のハッシュ値
+ * @return 本文の番号。見つからなければMESSAGE_TEXT_NONE
+ */
+uint32_t find_message_text(std::string_view str, uint32_t hash)
+{
+    for (uint32_t i = hash & (MESSAGE_INDEX_SIZE - 1);; i = (i + 1) & (MESSAGE_INDEX_SIZE - 1)) {
+        uint32_t text_id = message_history.index[i];
+        if (text_id == MESSAGE_TEXT_NONE)
+            return MESSAGE_TEXT_NONE;
+
+        if (text_id == MESSAGE_INDEX_DELETED)
+            continue;
+
+        const auto &text = message_history.texts[text_id];
+        if ((text.hash == hash) && (text.length == str.length()) && (std::memcmp(get_message_text(text_id), str.data(), str.length()) == 0))
+            return text_id;
+    }
+}
+
+void insert_message_index(uint32_t text_id)
+{
+    uint32_t i = message_history.texts[text_id].hash & (MESSAGE_INDEX_SIZE - 1);
+    while ((message_history.index[i] != MESSAGE_TEXT_NONE) && (message_history.index[i] != MESSAGE_INDEX_DELETED))
+        i = (i + 1) & (MESSAGE_INDEX_SIZE - 1);
+
+    if (message_history.index[i] == MESSAGE_TEXT_NONE)
+        message_history.index_used++;
+
+    message_history.index[i] = text_id;
+}
+
+void remove_message_index(uint32_t text_id)
+{
+    uint32_t i = message_history.texts[text_id].hash & (MESSAGE_INDEX_SIZE - 1);
+    while (message_history.index[i] != text_id)
+        i = (i + 1) & (MESSAGE_INDEX_SIZE - 1);
+
+    message_history.index[i] = MESSAGE_INDEX_DELETED;
+}
+
+/**
+ * @brief 削除済スロットが増えたハッシュ表を作り直す
+ */
+void rebuild_message_index(void)
+{
+    std::fill_n(message_history.index.get(), MESSAGE_INDEX_SIZE, MESSAGE_TEXT_NONE);
+    message_history.index_used = 0;
+    for (uint32_t text_id = 0; text_id < MESSAGE_TEXT_MAX; text_id++) {
+        if (message_history.texts[text_id].refcount > 0)
+            insert_message_index(text_id);
+    }
+}
+
+/**
+ * @brief 本文への参照を1つ減らし、参照がなくなれば本文を破棄する
+ * @param text_id 本文の番号
+ * @details 破棄した本文のブロックは、アリーナの末尾から解放されるまでそのまま残る。
+ */
+void release_message_text(uint32_t text_id)
+{
+    auto &text = message_history.texts[text_id];
+    if (--text.refcount > 0)
+        return;
+
+    remove_message_index(text_id);
+    auto *block = get_message_block(text.offset);
+    block->text_id = MESSAGE_TEXT_NONE;
+    message_history.arena_live -= block->size;
+    message_history.free_texts[message_history.free_text_num++] = text_id;
+}
+
+/**
+ * @brief 最も新しい履歴を消去する
+ */
+void pop_newest_message(void)
+{
+    message_history.entry_head = (message_history.entry_head + MESSAGE_MAX - 1) % MESSAGE_MAX;
+    message_history.entry_num--;
+    release_message_text(message_history.entries[message_history.entry_head]);
+}
+
+/**
+ * @brief 最も古い履歴を消去する
  */
-template <typename T>
-msg_sp make_message(T &&str)
+void pop_oldest_message(void)
 {
-    /** std::stringオブジェクトと同時にmessage_mapのエントリも削除するカスタムデリータ */
-    auto deleter = [](std::string *s) {
-        message_map.erase(s);
-        delete s;
-    };
+    uint32_t oldest = (message_history.entry_head + MESSAGE_MAX - message_history.entry_num) % MESSAGE_MAX;
+    message_history.entry_num--;
+    release_message_text(message_history.entries[oldest]);
+    message_history.stats.evicted++;
+}
+
+/**
+ * @brief アリーナの先頭の連続した空き領域に書き込めるかを返す
+ * @param size 書き込むバイト数
+ * @return 書き込めるならばTRUE
+ */
+bool can_write_message_block(uint32_t size)
+{
+    if (message_history.arena_used == 0) {
+        message_history.arena_head = 0;
+        message_history.arena_tail = 0;
+        return true;
+    }
+
+    if (message_history.arena_tail < message_history.arena_head) {
+        if (message_history.arena_head + size <= MESSAGE_BUF)
+            return true;
+
+        /* Pad the rest of the arena and wrap around */
+        uint32_t rest = MESSAGE_BUF - message_history.arena_head;
+        if (rest > 0) {
+            new (get_message_block(message_history.arena_head)) message_block_header{ MESSAGE_TEXT_NONE, rest };
+            message_history.arena_used += rest;
+        }
 
-    // 新たにメッセージを保持する msg_sp オブジェクトを生成し、検索用mapオブジェクトにも追加する
-    auto new_msg = msg_sp(new std::string(std::forward<T>(str)), std::move(deleter));
-    message_map.emplace(new_msg.get(), msg_wp(new_msg));
+        message_history.arena_head = 0;
+    }
 
-    return new_msg;
+    return message_history.arena_head + size <= message_history.arena_tail;
+}
+
+/**
+ * @brief アリーナの先頭にブロックを書き込む
+ * @param text_id 本文の番号
+ * @param str 本文
+ * @param size ブロック全体のバイト数
+ * @details 呼び出し前にcan_write_message_block()で空きを確認しておくこと。
+ */
+void write_message_block(uint32_t text_id, std::string_view str, uint32_t size)
+{
+    uint32_t offset = message_history.arena_head;
+    new (get_message_block(offset)) message_block_header{ text_id, size };
+    char *buf = &message_history.arena[offset + sizeof(message_block_header)];
+    std::memmove(buf, str.data(), str.length());
+    buf[str.length()] = '\0';
+
+    message_history.texts[text_id].offset = offset;
+    message_history.arena_head = offset + size;
+    message_history.arena_used += size;
+    message_history.arena_live += size;
+    message_history.stats.arena_bytes += size;
+}
+
+/**
+ * @brief アリーナの最も古いブロックを解放する
+ * @param reserve_size これから書き込むバイト数
+ * @details
+ * まだ参照されている本文は先頭へ移し替える。
+ * 参照中の本文と書き込むブロックがアリーナに収まらない場合に限り、先に古い履歴を消去する
+ * (アリーナの大きさからは起こり得ないが、移し替えが終わらなくなるのを防ぐ)。
+ */
+void release_oldest_message_block(uint32_t reserve_size)
+{
+    auto *block = get_message_block(message_history.arena_tail);
+    while ((block->text_id != MESSAGE_TEXT_NONE) && (message_history.arena_live + reserve_size + MESSAGE_BLOCK_MAX * 2 > MESSAGE_BUF))
+        pop_oldest_message();
+
+    uint32_t text_id = block->text_id;
+    uint32_t size = block->size;
+    message_history.arena_used -= size;
+    message_history.arena_tail += size;
+    if (message_history.arena_tail == MESSAGE_BUF)
+        message_history.arena_tail = 0;
+
+    if (text_id == MESSAGE_TEXT_NONE)
+        return;
+
+    /* 解放した領域は先頭の空き領域と隣接しているので、必ずそのまま書き込める */
+    const auto &text = message_history.texts[text_id];
+    char buf[MESSAGE_LENGTH_MAX + 1];
+    std::memcpy(buf, get_message_text(text_id), text.length);
+    message_history.arena_live -= size;
+    (void)can_write_message_block(size);
+    write_message_block(text_id, std::string_view(buf, text.length), size);
+}
+
+/**
+ * @brief 本文をアリーナに格納する
+ * @param str メッセージ本文
+ * @param hash 本文のハッシュ値
+ * @return 格納した本文の番号
+ */
+uint32_t store_message_text(std::string_view str, uint32_t hash)
+{
+    constexpr uint32_t align = sizeof(message_block_header);
+    uint32_t size = (sizeof(message_block_header) + str.length() + 1 + align - 1) / align * align;
+    while (!can_write_message_block(size))
+        release_oldest_message_block(size);
+
+    uint32_t text_id = message_history.free_texts[--message_history.free_text_num];
+    message_history.texts[text_id] = { 0, 0, hash, static_cast<uint32_t>(str.length()) };
+    write_message_block(text_id, str, size);
+    return text_id;
+}
+
+/**
+ * @brief メッセージ履歴の領域を確保する
+ */
+void initialize_message_history(void)
+{
+    message_history.arena = std::make_unique<char[]>(MESSAGE_BUF);
+    message_history.texts = std::make_unique<message_text_type[]>(MESSAGE_TEXT_MAX);
+    message_history.free_texts = std::make_unique<uint32_t[]>(MESSAGE_TEXT_MAX);
+    message_history.entries = std::make_unique<uint32_t[]>(MESSAGE_MAX);
+    message_history.index = std::make_unique<uint32_t[]>(MESSAGE_INDEX_SIZE);
+    std::fill_n(message_history.index.get(), MESSAGE_INDEX_SIZE, MESSAGE_TEXT_NONE);
+    for (uint32_t i = 0; i < MESSAGE_TEXT_MAX; i++)
+        message_history.free_texts[i] = MESSAGE_TEXT_MAX - 1 - i;
+
+    message_history.free_text_num = MESSAGE_TEXT_MAX;
+    message_history.stats.allocations += 5;
+}
+
+/**
+ * @brief メッセージ履歴に本文を追加する
+ * @param str メッセージ本文
+ */
+void push_message(std::string_view str)
+{
+    if (!message_history.arena)
+        initialize_message_history();
+
+    // メッセージ履歴から同一のメッセージを探し、なければアリーナに格納する
+    uint32_t hash = hash_message(str);
+    uint32_t text_id = find_message_text(str, hash);
+    if (text_id != MESSAGE_TEXT_NONE) {
+        message_history.stats.deduplicated++;
+    } else {
+        text_id = store_message_text(str, hash);
+        if (message_history.index_used >= MESSAGE_INDEX_SIZE / 4 * 3)
+            rebuild_message_index();
+
+        insert_message_index(text_id);
+    }
+
+    message_history.texts[text_id].refcount++;
+    message_history.entries[message_history.entry_head] = text_id;
+    message_history.entry_head = (message_history.entry_head + 1) % MESSAGE_MAX;
+    message_history.entry_num++;
+    message_history.stats.messages++;
+
+    if (message_history.entry_num == MESSAGE_MAX)
+        pop_oldest_message();
 }
 }
 
@@ -68,7 +381,7 @@ msg_sp make_message(T &&str)
  */
 int32_t message_num(void)
 {
-    return message_history.size();
+    return message_history.entry_num;
 }
 
 /*!
@@ -81,12 +394,23 @@ concptr message_str(int age)
     if ((age < 0) || (age >= message_num()))
         return ("");
 
-    return message_history[age]->c_str();
+    uint32_t entry = (message_history.entry_head + MESSAGE_MAX - 1 - age) % MESSAGE_MAX;
+    return get_message_text(message_history.entries[entry]);
+}
+
+/*!
+ * @brief メッセージ履歴の統計情報を返す / Get the statistics of the message history
+ * @return 統計情報
+ */
+const message_history_stats_type &get_message_history_stats(void)
+{
+    return message_history.stats;
 }
 
-static void message_add_aux(std::string str)
+static void message_add_aux(std::string_view str)
 {
-    std::string splitted;
+    std::string_view splitted;
+    char buf[128];
 
     if (str.empty())
         return;
@@ -116,9 +440,9 @@ static void message_add_aux(std::string str)
     }
 
     // 直前と同じメッセージの場合、「～ <xNN>」と表示する
-    if (!message_history.empty()) {
+    if (message_num() > 0) {
         const char *t;
-        std::string_view last_message = *message_history.front();
+        std::string_view last_message = message_str(0);
 #ifdef JP
         for (t = last_message.data(); *t && (*t != '<' || (*(t + 1) != 'x')); t++)
             if (iskanji(*t))
@@ -136,8 +460,11 @@ static void message_add_aux(std::string str)
         }
 
         if (str == last_message && (j < 1000)) {
-            str = format("%s <x%d>", str.c_str(), j + 1);
-            message_history.pop_front();
+            std::memcpy(buf, str.data(), str.length());
+            uint len = str.length();
+            len += strnfmt(buf + len, sizeof(buf) - len, " <x%d>", j + 1);
+            str = std::string_view(buf, len);
+            pop_newest_message();
             if (!now_message)
                 now_message++;
         } else {
@@ -147,25 +474,11 @@ static void message_add_aux(std::string str)
         }
     }
 
-    msg_sp add_msg;
-
-    // メッセージ履歴から同一のメッセージを探す
-    if (const auto &it = message_map.find(&str); it != message_map.end()) {
-        // 同一のメッセージが見つかったならそのメッセージの msg_sp オブジェクトを複製
-        add_msg = it->second.lock();
-    } else {
-        // 見つからなかった場合は新たに msg_sp オブジェクトを作成
-        add_msg = make_message(std::move(str));
-    }
-
     // メッセージ履歴に追加
-    message_history.push_front(std::move(add_msg));
-
-    if (message_history.size() == MESSAGE_MAX)
-        message_history.pop_back();
+    push_message(str);
 
     if (!splitted.empty()) {
-        message_add_aux(std::move(splitted));
+        message_add_aux(splitted);
     }
 }
 
@@ -273,7 +586,7 @@ void msg_print(concptr msg)
     char *t;
     char buf[1024];
 
-    if (current_world_ptr->timewalk_m_idx)
+    if (current_world_ptr->timewalk_m_idx || current_world_ptr->is_prefetching_floor)
         return;
 
     if (!msg_flag) {
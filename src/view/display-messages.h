@@ -8,11 +8,23 @@
  */
 #define MESSAGE_MAX 81920
 
+/*!
+ * @brief メッセージ履歴の統計情報 / Statistics of the message history
+ */
+struct message_history_stats_type {
+    uint32_t messages; //!< 追加されたメッセージの数
+    uint32_t deduplicated; //!< 既存の本文を共有したメッセージの数
+    uint32_t evicted; //!< 溢れて消去されたメッセージの数
+    uint32_t arena_bytes; //!< アリーナに書き込まれたバイト数の累計
+    uint32_t allocations; //!< メッセージ履歴のために行ったヒープ確保の回数
+};
+
 extern bool msg_flag;
 extern COMMAND_CODE now_message;
 
 int32_t message_num(void);
 concptr message_str(int age);
+const message_history_stats_type &get_message_history_stats(void);
 void message_add(concptr msg);
 void msg_erase(void);
 void msg_print(concptr msg);
@@ -44,9 +44,11 @@
 #include "window/main-window-equipments.h"
 #include "window/main-window-util.h"
 #include "world/world.h"
+#include <array>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 /*!
  * @brief サブウィンドウに所持品一覧を表示する / Hack -- display inventory in sub-windows
@@ -360,6 +362,62 @@ void fix_message(void)
     }
 }
 
+namespace {
+/*!
+ * @brief 周辺マップの1文字分の描画内容
+ */
+struct dungeon_view_cell_type {
+    TERM_COLOR a{}; //!< 文字色属性
+    SYMBOL_CODE c{}; //!< 文字種属性
+    TERM_COLOR ta{}; //!< 文字色属性(タイル)
+    SYMBOL_CODE tc{}; //!< 文字種属性(タイル)
+};
+
+/*!
+ * @brief 周辺マップのサブウィンドウに前回描いた内容 / Contents of a dungeon sub-window at its last draw
+ */
+struct dungeon_view_type {
+    bool is_drawn{}; //!< 描画済みか
+    term_type *term{}; //!< 描画先のTerm
+    BIT_FLAGS window_flag{}; //!< 描画時のサブウィンドウの表示内容
+    uint32_t generation{}; //!< 描画時の map_info() キャッシュの世代
+    uint64_t change_serial{}; //!< 描画時の変化したグリッドの記録の末尾
+    int tint{}; //!< 描画時の単色表示の種別
+    TERM_LEN wid{}; //!< 描画桁数
+    TERM_LEN hgt{}; //!< 描画行数
+    POSITION y{}; //!< 左上のグリッドのy座標
+    POSITION x{}; //!< 左上のグリッドのx座標
+    std::vector<dungeon_view_cell_type> cells; //!< 描いた内容
+    std::vector<map_grid_pos> volatile_grids; //!< 表示が乱数で変わるため毎回読み直すグリッド
+};
+
+/*!
+ * @brief 縮小マップのサブウィンドウに前回描いた内容 / Contents of an overhead sub-window at its last draw
+ */
+struct overhead_view_type {
+    term_type *term{}; //!< 描画先のTerm
+    BIT_FLAGS window_flag{}; //!< 描画時のサブウィンドウの表示内容
+    small_map_type map; //!< 描いた縮小マップ
+};
+
+std::array<dungeon_view_type, 8> dungeon_views;
+std::array<overhead_view_type, 8> overhead_views;
+}
+
+/*!
+ * @brief 前回描いた内容が今もサブウィンドウに残っているかを返す
+ * @param j サブウィンドウの番号
+ * @param term 前回描いたTerm
+ * @param flag 前回描いた時のサブウィンドウの表示内容
+ * @param view_flag 描画する表示内容 (PW_OVERHEAD / PW_DUNGEON)
+ * @return 前回の内容の上に変化した所だけを描いてよいならtrue
+ * @details 他の表示内容も選ばれているサブウィンドウは、前回以降に他の表示で上書きされているため全体を描き直す。
+ */
+static bool can_redraw_sub_window_incrementally(int j, term_type *term, BIT_FLAGS flag, BIT_FLAGS view_flag)
+{
+    return (term == Term) && (flag == window_flag[j]) && ((window_flag[j] & ~view_flag) == 0);
+}
+
 /*!
  * @brief 簡易マップをサブウィンドウに表示する /
  * Hack -- display overhead view in sub-windows
@@ -382,8 +440,15 @@ void fix_overhead(player_type *player_ptr)
         term_activate(angband_term[j]);
         term_get_size(&wid, &hgt);
         if (wid > COL_MAP + 2 && hgt > ROW_MAP + 2) {
+            auto &view = overhead_views[j];
+            if (!can_redraw_sub_window_incrementally(j, view.term, view.window_flag, PW_OVERHEAD)) {
+                view = overhead_view_type();
+                view.term = Term;
+                view.window_flag = window_flag[j];
+            }
+
             int cy, cx;
-            display_map(player_ptr, &cy, &cx);
+            display_map(player_ptr, &cy, &cx, &view.map);
             term_fresh();
         }
 
@@ -391,41 +456,139 @@ void fix_overhead(player_type *player_ptr)
     }
 }
 
+/*!
+ * @brief 周辺マップの1文字分を読み直す
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param view 周辺マップ
+ * @param y 描画行
+ * @param x 描画桁
+ */
+static void read_dungeon_view_cell(player_type *player_ptr, dungeon_view_type &view, TERM_LEN y, TERM_LEN x)
+{
+    auto &cell = view.cells[y * view.wid + x];
+    POSITION gy = view.y + y;
+    POSITION gx = view.x + x;
+    if (!in_bounds2(player_ptr->current_floor_ptr, gy, gx)) {
+        feature_type *f_ptr = &f_info[feat_none];
+        cell.a = cell.ta = f_ptr->x_attr[F_LIT_STANDARD];
+        cell.c = cell.tc = f_ptr->x_char[F_LIT_STANDARD];
+        return;
+    }
+
+    map_info_cached(player_ptr, gy, gx, &cell.a, &cell.c, &cell.ta, &cell.tc);
+    if (!use_graphics) {
+        if (current_world_ptr->timewalk_m_idx)
+            cell.a = TERM_DARK;
+        else if (is_invuln(player_ptr) || player_ptr->timewalk)
+            cell.a = TERM_WHITE;
+        else if (player_ptr->wraith_form)
+            cell.a = TERM_L_DARK;
+    }
+
+    if (!is_map_info_cacheable(player_ptr, gy, gx))
+        view.volatile_grids.push_back({ gy, gx });
+}
+
+/*!
+ * @brief 周辺マップの1文字分を描く
+ * @param view 周辺マップ
+ * @param y 描画行
+ * @param x 描画桁
+ */
+static void draw_dungeon_view_cell(const dungeon_view_type &view, TERM_LEN y, TERM_LEN x)
+{
+    const auto &cell = view.cells[y * view.wid + x];
+    term_queue_char(x, y, cell.a, cell.c, cell.ta, cell.tc);
+}
+
 /*!
  * @brief 自分の周辺の地形をTermに表示する
  * @param プレイヤー情報への参照ポインタ
+ * @param view 前回描いた内容
+ * @details
+ * プレイヤーが移動した時は前回描いた内容をずらして使い、新たに見える範囲と表示が変わりうるグリッドだけを読み直す。
+ * ずらした時は全ての文字を、そうでなければ読み直した文字だけをTermに送る。
  */
-static void display_dungeon(player_type *player_ptr)
+static void display_dungeon(player_type *player_ptr, dungeon_view_type &view)
 {
-    TERM_COLOR ta = 0;
-    SYMBOL_CODE tc = '\0';
-
-    for (TERM_LEN x = player_ptr->x - Term->wid / 2 + 1; x <= player_ptr->x + Term->wid / 2; x++) {
-        for (TERM_LEN y = player_ptr->y - Term->hgt / 2 + 1; y <= player_ptr->y + Term->hgt / 2; y++) {
-            TERM_COLOR a;
-            SYMBOL_CODE c;
-            if (!in_bounds2(player_ptr->current_floor_ptr, y, x)) {
-                feature_type *f_ptr = &f_info[feat_none];
-                a = f_ptr->x_attr[F_LIT_STANDARD];
-                c = f_ptr->x_char[F_LIT_STANDARD];
-                term_queue_char(x - player_ptr->x + Term->wid / 2 - 1, y - player_ptr->y + Term->hgt / 2 - 1, a, c, ta, tc);
-                continue;
+    TERM_LEN wid = (Term->wid / 2) * 2;
+    TERM_LEN hgt = (Term->hgt / 2) * 2;
+    POSITION y0 = player_ptr->y - Term->hgt / 2 + 1;
+    POSITION x0 = player_ptr->x - Term->wid / 2 + 1;
+
+    std::vector<map_grid_pos> changes;
+    bool is_rebuild_needed = !view.is_drawn || (view.wid != wid) || (view.hgt != hgt);
+    is_rebuild_needed |= player_ptr->image || (view.tint != get_map_tint(player_ptr));
+    is_rebuild_needed |= (view.generation != get_map_info_generation(player_ptr));
+    is_rebuild_needed |= !get_map_changes_since(view.change_serial, changes);
+    if (is_rebuild_needed) {
+        view.wid = wid;
+        view.hgt = hgt;
+        view.y = y0;
+        view.x = x0;
+        view.cells.assign(wid * hgt, dungeon_view_cell_type());
+        view.volatile_grids.clear();
+        for (TERM_LEN x = 0; x < wid; x++) {
+            for (TERM_LEN y = 0; y < hgt; y++) {
+                read_dungeon_view_cell(player_ptr, view, y, x);
+                draw_dungeon_view_cell(view, y, x);
             }
+        }
+    } else {
+        std::vector<bool> is_read(wid * hgt, false);
+        const bool is_scrolled = (view.y != y0) || (view.x != x0);
+        if (is_scrolled) {
+            std::vector<dungeon_view_cell_type> old_cells = std::move(view.cells);
+            POSITION dy = y0 - view.y;
+            POSITION dx = x0 - view.x;
+            view.cells.assign(wid * hgt, dungeon_view_cell_type());
+            view.y = y0;
+            view.x = x0;
+            for (TERM_LEN y = 0; y < hgt; y++) {
+                for (TERM_LEN x = 0; x < wid; x++) {
+                    TERM_LEN old_y = y + dy;
+                    TERM_LEN old_x = x + dx;
+                    if ((old_y < 0) || (old_y >= hgt) || (old_x < 0) || (old_x >= wid)) {
+                        read_dungeon_view_cell(player_ptr, view, y, x);
+                        is_read[y * wid + x] = true;
+                    } else {
+                        view.cells[y * wid + x] = old_cells[old_y * wid + old_x];
+                    }
+                }
+            }
+        }
 
-            map_info(player_ptr, y, x, &a, &c, &ta, &tc);
-
-            if (!use_graphics) {
-                if (current_world_ptr->timewalk_m_idx)
-                    a = TERM_DARK;
-                else if (is_invuln(player_ptr) || player_ptr->timewalk)
-                    a = TERM_WHITE;
-                else if (player_ptr->wraith_form)
-                    a = TERM_L_DARK;
+        for (const auto &[gy, gx] : view.volatile_grids)
+            changes.push_back({ gy, gx });
+
+        view.volatile_grids.clear();
+        for (const auto &[cy, cx] : changes) {
+            for (POSITION gy = cy - 1; gy <= cy + 1; gy++) {
+                for (POSITION gx = cx - 1; gx <= cx + 1; gx++) {
+                    TERM_LEN y = gy - view.y;
+                    TERM_LEN x = gx - view.x;
+                    if ((y < 0) || (y >= hgt) || (x < 0) || (x >= wid) || is_read[y * wid + x])
+                        continue;
+
+                    read_dungeon_view_cell(player_ptr, view, y, x);
+                    is_read[y * wid + x] = true;
+                    if (!is_scrolled)
+                        draw_dungeon_view_cell(view, y, x);
+                }
             }
+        }
 
-            term_queue_char(x - player_ptr->x + Term->wid / 2 - 1, y - player_ptr->y + Term->hgt / 2 - 1, a, c, ta, tc);
+        if (is_scrolled) {
+            for (TERM_LEN y = 0; y < hgt; y++)
+                for (TERM_LEN x = 0; x < wid; x++)
+                    draw_dungeon_view_cell(view, y, x);
         }
     }
+
+    view.is_drawn = !player_ptr->image;
+    view.tint = get_map_tint(player_ptr);
+    view.generation = get_map_info_generation(player_ptr);
+    view.change_serial = get_map_change_serial();
 }
 
 /*!
@@ -443,7 +606,14 @@ void fix_dungeon(player_type *player_ptr)
             continue;
 
         term_activate(angband_term[j]);
-        display_dungeon(player_ptr);
+        auto &view = dungeon_views[j];
+        if (!can_redraw_sub_window_incrementally(j, view.term, view.window_flag, PW_DUNGEON)) {
+            view = dungeon_view_type();
+            view.term = Term;
+            view.window_flag = window_flag[j];
+        }
+
+        display_dungeon(player_ptr, view);
         term_fresh();
         term_activate(old);
     }
@@ -17,6 +17,7 @@
 #include "term/term-color-types.h"
 #include "view/display-map.h"
 #include "world/world.h"
+#include <algorithm>
 #include <vector>
 
 /*
@@ -76,6 +77,9 @@ void print_map(player_type *player_ptr)
 
     (void)term_set_cursor(0);
 
+    /* Anything may have changed since the last full redraw */
+    clear_map_info_cache();
+
     floor_type *floor_ptr = player_ptr->current_floor_ptr;
     POSITION xmin = (0 < panel_col_min) ? panel_col_min : 0;
     POSITION xmax = (floor_ptr->width - 1 > panel_col_max) ? panel_col_max : floor_ptr->width - 1;
@@ -96,7 +100,7 @@ void print_map(player_type *player_ptr)
             SYMBOL_CODE c;
             TERM_COLOR ta;
             SYMBOL_CODE tc;
-            map_info(player_ptr, y, x, &a, &c, &ta, &tc);
+            map_info_cached(player_ptr, y, x, &a, &c, &ta, &tc);
             if (!use_graphics) {
                 if (current_world_ptr->timewalk_m_idx)
                     a = TERM_DARK;
@@ -176,148 +180,362 @@ static void display_shortened_item_name(player_type *player_ptr, object_type *o_
 }
 
 /*!
- * @brief 縮小マップ表示 / Display a "small-scale" map of the dungeon in the active Term
+ * @brief 時間停止・無敵・幽体化による単色表示を適用する
  * @param player_ptr プレイヤー情報への参照ポインタ
- * @param cy 縮小マップ上のプレイヤーのy座標
- * @param cx 縮小マップ上のプレイヤーのx座標
- * @details
- * メインウィンドウ('M'コマンド)、サブウィンドウ兼(縮小図)用。
- * use_bigtile時に横の描画列数は1/2になる。
+ * @param a 本来の文字色
+ * @return 表示する文字色
  */
-void display_map(player_type *player_ptr, int *cy, int *cx)
+static TERM_COLOR get_map_tint_attr(player_type *player_ptr, TERM_COLOR a)
 {
-    int i, j, x, y;
+    if (use_graphics)
+        return a;
 
-    TERM_COLOR ta;
-    SYMBOL_CODE tc;
+    if (current_world_ptr->timewalk_m_idx)
+        return TERM_DARK;
+    else if (is_invuln(player_ptr) || player_ptr->timewalk)
+        return TERM_WHITE;
+    else if (player_ptr->wraith_form)
+        return TERM_L_DARK;
 
-    byte tp;
+    return a;
+}
 
-    bool old_view_special_lite = view_special_lite;
-    bool old_view_granite_lite = view_granite_lite;
+/*!
+ * @brief 単色表示の種別を返す。変わったら全体を描き直す
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @return 単色表示の種別
+ */
+int get_map_tint(player_type *player_ptr)
+{
+    return (get_map_tint_attr(player_ptr, TERM_WHITE) << 8) | get_map_tint_attr(player_ptr, TERM_RED);
+}
 
-    TERM_LEN border_width = use_bigtile ? 2 : 1; //!< @note 枠線幅
-    TERM_LEN hgt, wid, yrat, xrat;
-    term_get_size(&wid, &hgt);
-    hgt -= 2;
-    wid -= 12 + border_width * 2; //!< @note 描画桁数(枠線抜)
-    if (use_bigtile)
-        wid = wid / 2 - 1;
+/*!
+ * @brief 縮小マップの升目に対応するグリッドの範囲を返す
+ * @param map 縮小マップ
+ * @param y 升目の行 (1 から hgt)
+ * @param x 升目の桁 (1 から wid)
+ * @param y1 範囲の上端
+ * @param x1 範囲の左端
+ * @param y2 範囲の下端 (含まない)
+ * @param x2 範囲の右端 (含まない)
+ */
+static void get_small_map_block(const small_map_type &map, int y, int x, POSITION *y1, POSITION *x1, POSITION *y2, POSITION *x2)
+{
+    *y1 = (y - 1) * map.yrat;
+    *x1 = (x - 1) * map.xrat;
+    *y2 = std::min<POSITION>(y * map.yrat, map.floor_hgt);
+    *x2 = std::min<POSITION>(x * map.xrat, map.floor_wid);
+}
 
-    floor_type *floor_ptr = player_ptr->current_floor_ptr;
-    yrat = (floor_ptr->height + hgt - 1) / hgt;
-    xrat = (floor_ptr->width + wid - 1) / wid;
-    view_special_lite = false;
-    view_granite_lite = false;
+/*!
+ * @brief 縮小マップ用に1グリッド分の表示を読み直す
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param map 縮小マップ
+ * @param j グリッドのy座標
+ * @param i グリッドのx座標
+ */
+static void read_small_map_grid(player_type *player_ptr, small_map_type &map, POSITION j, POSITION i)
+{
+    TERM_COLOR ta;
+    SYMBOL_CODE tc;
+    map_info_cached(player_ptr, j, i, &ta, &tc, &ta, &tc);
+    map.bigmc[(j + 1) * (map.floor_wid + 2) + (i + 1)] = tc;
+    map.bigma[(j + 1) * (map.floor_wid + 2) + (i + 1)] = ta;
+    map.priority[j * map.floor_wid + i] = (byte)feat_priority;
+    map.match[j * map.floor_wid + i] = match_autopick;
+    map.autopick_objects[j * map.floor_wid + i] = autopick_obj;
+    if (!is_map_info_cacheable(player_ptr, j, i))
+        map.volatile_grids.push_back({ j, i });
+}
 
-    using std::vector;
-    vector<vector<TERM_COLOR>> ma(hgt + 2, vector<TERM_COLOR>(wid + 2, TERM_WHITE));
-    vector<vector<SYMBOL_CODE>> mc(hgt + 2, vector<SYMBOL_CODE>(wid + 2, ' '));
-    vector<vector<byte>> mp(hgt + 2, vector<byte>(wid + 2, 0));
-    vector<vector<int>> match_autopick_yx(hgt + 2, vector<int>(wid + 2, -1));
-    vector<vector<object_type *>> object_autopick_yx(hgt + 2, vector<object_type *>(wid + 2, NULL));
-
-    vector<vector<TERM_COLOR>> bigma(floor_ptr->height + 2, vector<TERM_COLOR>(floor_ptr->width + 2, TERM_WHITE));
-    vector<vector<SYMBOL_CODE>> bigmc(floor_ptr->height + 2, vector<SYMBOL_CODE>(floor_ptr->width + 2, ' '));
-    vector<vector<byte>> bigmp(floor_ptr->height + 2, vector<byte>(floor_ptr->width + 2, 0));
-
-    for (i = 0; i < floor_ptr->width; ++i) {
-        for (j = 0; j < floor_ptr->height; ++j) {
-            x = i / xrat + 1;
-            y = j / yrat + 1;
-
-            match_autopick = -1;
-            autopick_obj = NULL;
-            feat_priority = -1;
-            map_info(player_ptr, j, i, &ta, &tc, &ta, &tc);
-            tp = (byte)feat_priority;
-            if (match_autopick != -1 && (match_autopick_yx[y][x] == -1 || match_autopick_yx[y][x] > match_autopick)) {
-                match_autopick_yx[y][x] = match_autopick;
-                object_autopick_yx[y][x] = autopick_obj;
+/*!
+ * @brief 升目内のグリッドの表示優先度と自動拾いの一致を決める
+ * @param map 縮小マップ
+ * @param y 升目の行
+ * @param x 升目の桁
+ * @details グリッドを x, y の順に走査する。順序により優先度が変わるため升目単位でやり直す。
+ */
+static void build_small_map_block_priority(small_map_type &map, int y, int x)
+{
+    POSITION y1, x1, y2, x2;
+    get_small_map_block(map, y, x, &y1, &x1, &y2, &x2);
+    const int cell = y * (map.wid + 2) + x;
+    map.match_autopick_yx[cell] = -1;
+    map.object_autopick_yx[cell] = NULL;
+    for (POSITION i = x1; i < x2; ++i) {
+        for (POSITION j = y1; j < y2; ++j) {
+            byte tp = map.priority[j * map.floor_wid + i];
+            int match = map.match[j * map.floor_wid + i];
+            if (match != -1 && (map.match_autopick_yx[cell] == -1 || map.match_autopick_yx[cell] > match)) {
+                map.match_autopick_yx[cell] = match;
+                map.object_autopick_yx[cell] = map.autopick_objects[j * map.floor_wid + i];
                 tp = 0x7f;
             }
 
-            bigmc[j + 1][i + 1] = tc;
-            bigma[j + 1][i + 1] = ta;
-            bigmp[j + 1][i + 1] = tp;
+            map.bigmp[(j + 1) * (map.floor_wid + 2) + (i + 1)] = tp;
         }
     }
+}
 
-    for (j = 0; j < floor_ptr->height; ++j) {
-        for (i = 0; i < floor_ptr->width; ++i) {
-            x = i / xrat + 1;
-            y = j / yrat + 1;
-
-            tc = bigmc[j + 1][i + 1];
-            ta = bigma[j + 1][i + 1];
-            tp = bigmp[j + 1][i + 1];
-            if (mp[y][x] == tp) {
-                int t;
+/*!
+ * @brief 升目に表示する文字を升目内のグリッドから選ぶ
+ * @param map 縮小マップ
+ * @param y 升目の行
+ * @param x 升目の桁
+ */
+static void build_small_map_cell(small_map_type &map, int y, int x)
+{
+    POSITION y1, x1, y2, x2;
+    get_small_map_block(map, y, x, &y1, &x1, &y2, &x2);
+    const int cell = y * (map.wid + 2) + x;
+    const int bigwid = map.floor_wid + 2;
+    map.mc[cell] = ' ';
+    map.ma[cell] = TERM_WHITE;
+    map.mp[cell] = 0;
+    for (POSITION j = y1; j < y2; ++j) {
+        for (POSITION i = x1; i < x2; ++i) {
+            const int grid = (j + 1) * bigwid + (i + 1);
+            SYMBOL_CODE tc = map.bigmc[grid];
+            TERM_COLOR ta = map.bigma[grid];
+            byte tp = map.bigmp[grid];
+            if (map.mp[cell] == tp) {
                 int cnt = 0;
-
-                for (t = 0; t < 8; t++) {
-                    if (tc == bigmc[j + 1 + ddy_cdd[t]][i + 1 + ddx_cdd[t]] && ta == bigma[j + 1 + ddy_cdd[t]][i + 1 + ddx_cdd[t]])
+                for (int t = 0; t < 8; t++) {
+                    const int neighbor = grid + ddy_cdd[t] * bigwid + ddx_cdd[t];
+                    if (tc == map.bigmc[neighbor] && ta == map.bigma[neighbor])
                         cnt++;
                 }
                 if (cnt <= 4)
                     tp++;
             }
 
-            if (mp[y][x] < tp) {
-                mc[y][x] = tc;
-                ma[y][x] = ta;
-                mp[y][x] = tp;
+            if (map.mp[cell] < tp) {
+                map.mc[cell] = tc;
+                map.ma[cell] = ta;
+                map.mp[cell] = tp;
             }
         }
     }
+}
 
-    x = wid + 1;
-    y = hgt + 1;
+/*!
+ * @brief 縮小マップの升目を1つ描く
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param map 縮小マップ
+ * @param y 升目の行
+ * @param x 升目の桁
+ */
+static void draw_small_map_cell(player_type *player_ptr, const small_map_type &map, int y, int x)
+{
+    const int cell = y * (map.wid + 2) + x;
+    term_gotoxy(COL_MAP + (map.bigtile ? x * 2 : x), y);
+    term_add_bigch(get_map_tint_attr(player_ptr, map.ma[cell]), map.mc[cell]);
+}
+
+/*!
+ * @brief 縮小マップの行の左に、その行で自動拾いに一致したアイテムの名前を描く
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param map 縮小マップ
+ * @param y 升目の行
+ */
+static void draw_small_map_row_name(player_type *player_ptr, const small_map_type &map, int y)
+{
+    match_autopick = -1;
+    for (int x = 1; x <= map.wid; x++) {
+        const int cell = y * (map.wid + 2) + x;
+        if (map.match_autopick_yx[cell] != -1 && (match_autopick > map.match_autopick_yx[cell] || match_autopick == -1)) {
+            match_autopick = map.match_autopick_yx[cell];
+            autopick_obj = map.object_autopick_yx[cell];
+        }
+    }
+
+    term_putstr(0, y, 12, 0, "            ");
+    if (match_autopick != -1)
+        display_shortened_item_name(player_ptr, autopick_obj, y);
+}
 
-    mc[0][0] = mc[0][x] = mc[y][0] = mc[y][x] = '+';
+/*!
+ * @brief 縮小マップ全体を作り直して描く
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param map 縮小マップ
+ * @param wid 描画桁数(枠線抜)
+ * @param hgt 描画行数(枠線抜)
+ */
+static void build_small_map(player_type *player_ptr, small_map_type &map, TERM_LEN wid, TERM_LEN hgt)
+{
+    floor_type *floor_ptr = player_ptr->current_floor_ptr;
+    map.wid = wid;
+    map.hgt = hgt;
+    map.bigtile = use_bigtile;
+    map.floor_hgt = floor_ptr->height;
+    map.floor_wid = floor_ptr->width;
+    map.yrat = (floor_ptr->height + hgt - 1) / hgt;
+    map.xrat = (floor_ptr->width + wid - 1) / wid;
+
+    const size_t cells = (hgt + 2) * (wid + 2);
+    map.ma.assign(cells, TERM_WHITE);
+    map.mc.assign(cells, ' ');
+    map.mp.assign(cells, 0);
+    map.match_autopick_yx.assign(cells, -1);
+    map.object_autopick_yx.assign(cells, NULL);
+
+    const size_t biggrids = (floor_ptr->height + 2) * (floor_ptr->width + 2);
+    map.bigma.assign(biggrids, TERM_WHITE);
+    map.bigmc.assign(biggrids, ' ');
+    map.bigmp.assign(biggrids, 0);
+
+    const size_t grids = floor_ptr->height * floor_ptr->width;
+    map.priority.assign(grids, 0);
+    map.match.assign(grids, -1);
+    map.autopick_objects.assign(grids, NULL);
+    map.volatile_grids.clear();
+
+    for (POSITION i = 0; i < floor_ptr->width; ++i)
+        for (POSITION j = 0; j < floor_ptr->height; ++j)
+            read_small_map_grid(player_ptr, map, j, i);
+
+    for (int x = 1; x <= wid; x++)
+        for (int y = 1; y <= hgt; y++)
+            build_small_map_block_priority(map, y, x);
+
+    for (int y = 1; y <= hgt; y++)
+        for (int x = 1; x <= wid; x++)
+            build_small_map_cell(map, y, x);
+
+    int x = wid + 1;
+    int y = hgt + 1;
+    map.mc[0] = map.mc[x] = map.mc[y * (wid + 2)] = map.mc[y * (wid + 2) + x] = '+';
     for (x = 1; x <= wid; x++)
-        mc[0][x] = mc[y][x] = '-';
+        map.mc[x] = map.mc[y * (wid + 2) + x] = '-';
 
+    x = wid + 1;
     for (y = 1; y <= hgt; y++)
-        mc[y][0] = mc[y][x] = '|';
+        map.mc[y * (wid + 2)] = map.mc[y * (wid + 2) + x] = '|';
 
     for (y = 0; y < hgt + 2; ++y) {
         term_gotoxy(COL_MAP, y);
-        for (x = 0; x < wid + 2; ++x) {
-            ta = ma[y][x];
-            tc = mc[y][x];
-            if (!use_graphics) {
-                if (current_world_ptr->timewalk_m_idx)
-                    ta = TERM_DARK;
-                else if (is_invuln(player_ptr) || player_ptr->timewalk)
-                    ta = TERM_WHITE;
-                else if (player_ptr->wraith_form)
-                    ta = TERM_L_DARK;
-            }
+        for (x = 0; x < wid + 2; ++x)
+            term_add_bigch(get_map_tint_attr(player_ptr, map.ma[y * (wid + 2) + x]), map.mc[y * (wid + 2) + x]);
+    }
 
-            term_add_bigch(ta, tc);
-        }
+    for (y = 1; y < hgt + 1; ++y)
+        draw_small_map_row_name(player_ptr, map, y);
+}
+
+/*!
+ * @brief 前回描いた縮小マップのうち、表示が変わりうるグリッドを含む升目だけを描き直す
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param map 縮小マップ
+ * @param changes 前回の描画以降に変化したグリッド
+ * @details 升目の文字は周囲のグリッドとの比較で決まるため、変化したグリッドの周囲を含む升目も作り直す。
+ */
+static void update_small_map(player_type *player_ptr, small_map_type &map, const std::vector<map_grid_pos> &changes)
+{
+    std::vector<map_grid_pos> grids = std::move(map.volatile_grids);
+    map.volatile_grids.clear();
+    for (const auto &[cy, cx] : changes) {
+        for (POSITION j = std::max<POSITION>(cy - 1, 0); j <= std::min<POSITION>(cy + 1, map.floor_hgt - 1); j++)
+            for (POSITION i = std::max<POSITION>(cx - 1, 0); i <= std::min<POSITION>(cx + 1, map.floor_wid - 1); i++)
+                grids.push_back({ j, i });
+    }
+
+    const int cellwid = map.wid + 2;
+    std::vector<byte> block_flags((map.hgt + 2) * cellwid, 0);
+    std::vector<bool> is_read(map.floor_hgt * map.floor_wid, false);
+    constexpr byte REBUILD_PRIORITY = 0x01;
+    constexpr byte REBUILD_CELL = 0x02;
+    for (const auto &[j, i] : grids) {
+        if (is_read[j * map.floor_wid + i])
+            continue;
+
+        is_read[j * map.floor_wid + i] = true;
+        read_small_map_grid(player_ptr, map, j, i);
+        block_flags[(j / map.yrat + 1) * cellwid + (i / map.xrat + 1)] |= REBUILD_PRIORITY;
+        for (POSITION y = std::max<POSITION>(j - 1, 0); y <= std::min<POSITION>(j + 1, map.floor_hgt - 1); y++)
+            for (POSITION x = std::max<POSITION>(i - 1, 0); x <= std::min<POSITION>(i + 1, map.floor_wid - 1); x++)
+                block_flags[(y / map.yrat + 1) * cellwid + (x / map.xrat + 1)] |= REBUILD_CELL;
     }
 
-    for (y = 1; y < hgt + 1; ++y) {
-        match_autopick = -1;
-        for (x = 1; x <= wid; x++) {
-            if (match_autopick_yx[y][x] != -1 && (match_autopick > match_autopick_yx[y][x] || match_autopick == -1)) {
-                match_autopick = match_autopick_yx[y][x];
-                autopick_obj = object_autopick_yx[y][x];
+    for (int y = 1; y <= map.hgt; y++) {
+        bool is_row_changed = false;
+        for (int x = 1; x <= map.wid; x++) {
+            if (block_flags[y * cellwid + x] & REBUILD_PRIORITY) {
+                build_small_map_block_priority(map, y, x);
+                is_row_changed = true;
             }
         }
 
-        term_putstr(0, y, 12, 0, "            ");
-        if (match_autopick != -1)
-            display_shortened_item_name(player_ptr, autopick_obj, y);
+        for (int x = 1; x <= map.wid; x++) {
+            if (block_flags[y * cellwid + x] == 0)
+                continue;
+
+            build_small_map_cell(map, y, x);
+            draw_small_map_cell(player_ptr, map, y, x);
+        }
+
+        if (is_row_changed)
+            draw_small_map_row_name(player_ptr, map, y);
+    }
+}
+
+/*!
+ * @brief 縮小マップ表示 / Display a "small-scale" map of the dungeon in the active Term
+ * @param player_ptr プレイヤー情報への参照ポインタ
+ * @param cy 縮小マップ上のプレイヤーのy座標
+ * @param cx 縮小マップ上のプレイヤーのx座標
+ * @param map 前回の描画内容。NULLならば毎回全体を描く
+ * @details
+ * メインウィンドウ('M'コマンド)、サブウィンドウ兼(縮小図)用。
+ * use_bigtile時に横の描画列数は1/2になる。
+ * サブウィンドウでは前回描いた内容を map に持ち、それ以降に表示が変わりうるグリッドを含む升目だけを描き直す。
+ */
+void display_map(player_type *player_ptr, int *cy, int *cx, small_map_type *map)
+{
+    bool old_view_special_lite = view_special_lite;
+    bool old_view_granite_lite = view_granite_lite;
+
+    TERM_LEN border_width = use_bigtile ? 2 : 1; //!< @note 枠線幅
+    TERM_LEN hgt, wid;
+    term_get_size(&wid, &hgt);
+    hgt -= 2;
+    wid -= 12 + border_width * 2; //!< @note 描画桁数(枠線抜)
+    if (use_bigtile)
+        wid = wid / 2 - 1;
+
+    view_special_lite = false;
+    view_granite_lite = false;
+
+    floor_type *floor_ptr = player_ptr->current_floor_ptr;
+    if (map == NULL) {
+        small_map_type tmp_map;
+        build_small_map(player_ptr, tmp_map, wid, hgt);
+        *cy = player_ptr->y / tmp_map.yrat + 1 + ROW_MAP;
+        *cx = player_ptr->x / tmp_map.xrat + 1;
+    } else {
+        std::vector<map_grid_pos> changes;
+        bool is_rebuild_needed = !map->is_drawn || (map->wid != wid) || (map->hgt != hgt) || (map->bigtile != use_bigtile);
+        is_rebuild_needed |= (map->floor_hgt != floor_ptr->height) || (map->floor_wid != floor_ptr->width);
+        is_rebuild_needed |= player_ptr->image || (map->tint != get_map_tint(player_ptr));
+        is_rebuild_needed |= (map->generation != get_map_info_generation(player_ptr));
+        is_rebuild_needed |= !get_map_changes_since(map->change_serial, changes);
+        if (is_rebuild_needed)
+            build_small_map(player_ptr, *map, wid, hgt);
+        else
+            update_small_map(player_ptr, *map, changes);
+
+        map->is_drawn = !player_ptr->image;
+        map->tint = get_map_tint(player_ptr);
+        map->generation = get_map_info_generation(player_ptr);
+        map->change_serial = get_map_change_serial();
+        *cy = player_ptr->y / map->yrat + 1 + ROW_MAP;
+        *cx = player_ptr->x / map->xrat + 1;
     }
 
-    (*cy) = player_ptr->y / yrat + 1 + ROW_MAP;
     if (!use_bigtile)
-        (*cx) = player_ptr->x / xrat + 1 + COL_MAP;
+        (*cx) += COL_MAP;
     else
-        (*cx) = (player_ptr->x / xrat + 1) * 2 + COL_MAP;
+        (*cx) = (*cx) * 2 + COL_MAP;
 
     view_special_lite = old_view_special_lite;
     view_granite_lite = old_view_granite_lite;
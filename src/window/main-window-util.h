@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include "system/angband.h"
+#include "view/display-map.h"
+#include <vector>
 
 #define ROW_MAP 0
 #define COL_MAP 12
@@ -16,9 +18,40 @@ extern POSITION panel_row_prt;
 extern int match_autopick;
 extern int feat_priority;
 
+/*!
+ * @brief 縮小マップの描画内容 / Contents of a small-scale map drawn in a sub-window
+ * @details 升目は (hgt + 2) * (wid + 2)、big で始まる配列は周囲1マスを足した階の大きさで持つ。
+ */
+struct small_map_type {
+    bool is_drawn{}; //!< 描画済みか
+    uint32_t generation{}; //!< 描画時の map_info() キャッシュの世代
+    uint64_t change_serial{}; //!< 描画時の変化したグリッドの記録の末尾
+    int tint{}; //!< 描画時の単色表示の種別
+    bool bigtile{}; //!< 描画時の use_bigtile
+    TERM_LEN wid{}; //!< 描画桁数(枠線抜)
+    TERM_LEN hgt{}; //!< 描画行数(枠線抜)
+    POSITION floor_wid{}; //!< 階の横幅
+    POSITION floor_hgt{}; //!< 階の縦幅
+    POSITION xrat{}; //!< 1升目あたりのグリッドの桁数
+    POSITION yrat{}; //!< 1升目あたりのグリッドの行数
+    std::vector<TERM_COLOR> ma; //!< 升目の文字色
+    std::vector<SYMBOL_CODE> mc; //!< 升目の文字
+    std::vector<byte> mp; //!< 升目の表示優先度
+    std::vector<int> match_autopick_yx; //!< 升目内で自動拾いに一致した登録番号
+    std::vector<object_type *> object_autopick_yx; //!< 升目内で自動拾いに一致したアイテム
+    std::vector<TERM_COLOR> bigma; //!< グリッドの文字色
+    std::vector<SYMBOL_CODE> bigmc; //!< グリッドの文字
+    std::vector<byte> bigmp; //!< グリッドの表示優先度
+    std::vector<byte> priority; //!< グリッドの地形・アイテム・モンスターによる表示優先度
+    std::vector<int> match; //!< グリッドで自動拾いに一致した登録番号
+    std::vector<object_type *> autopick_objects; //!< グリッドで自動拾いに一致したアイテム
+    std::vector<map_grid_pos> volatile_grids; //!< 表示が乱数で変わるため毎回読み直すグリッド
+};
+
 typedef struct player_type player_type;
 void print_field(concptr info, TERM_LEN row, TERM_LEN col);
 void print_map(player_type *player_ptr);
-void display_map(player_type *player_ptr, int *cy, int *cx);
+void display_map(player_type *player_ptr, int *cy, int *cx, small_map_type *map = NULL);
 void set_term_color(player_type *player_ptr, POSITION y, POSITION x, TERM_COLOR *ap, SYMBOL_CODE *cp);
 int panel_col_of(int col);
+int get_map_tint(player_type *player_ptr);
@@ -41,7 +41,7 @@
 /*!
  * @brief デバグコマンド一覧表
  * @details
- * 空き: A,B,E,I,J,k,K,L,M,q,Q,R,T,U,V,W,y,Y
+ * 空き: A,B,E,I,J,k,K,L,q,Q,R,T,U,V,W,y,Y
  */
 std::vector<std::vector<std::string>> debug_menu_table = {
     { "a", _("全状態回復", "Restore all status") },
@@ -61,6 +61,7 @@ std::vector<std::vector<std::string>> debug_menu_table = {
     { "j", _("指定ダンジョン階にワープ", "Jump to floor depth of target dungeon") },
     { "k", _("指定ダメージ・半径0の指定属性のボールを自分に放つ", "Fire a zero ball to self") },
     { "m", _("魔法の地図", "Magic mapping") },
+    { "M", _("メッセージ履歴の統計を表示", "Show message history statistics") },
     { "n", _("指定モンスター生成", "Summon target monster") },
     { "N", _("指定モンスターをペットとして生成", "Summon target monster as pet") },
     { "o", _("オブジェクトの能力変更", "Modift object abilities") },
@@ -181,6 +182,9 @@ bool exe_cmd_debug(player_type *creature_ptr, char cmd)
     case 'm':
         map_area(creature_ptr, DETECT_RAD_ALL * 3);
         break;
+    case 'M':
+        wiz_show_message_stats();
+        break;
     case 'r':
         gain_level_reward(creature_ptr, command_arg);
         break;
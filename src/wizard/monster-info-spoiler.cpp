@@ -74,7 +74,6 @@ static concptr attr_to_text(monster_race *r_ptr)
 
 spoiler_output_status spoil_mon_desc(concptr fname, std::function<bool(const monster_race *)> filter_monster)
 {
-    player_type dummy;
     uint16_t why = 2;
     MONRACE_IDX *who;
     char buf[1024];
@@ -111,7 +110,7 @@ spoiler_output_status spoil_mon_desc(concptr fname, std::function<bool(const mon
             who[n++] = (int16_t)i;
     }
 
-    ang_sort(&dummy, who, &why, n, ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, n, [why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     for (auto i = 0; i < n; i++) {
         monster_race *r_ptr = &r_info[who[i]];
         concptr name = r_ptr->name.c_str();
@@ -186,7 +185,6 @@ static void roff_func(TERM_COLOR attr, concptr str)
  */
 spoiler_output_status spoil_mon_info(concptr fname)
 {
-    player_type dummy;
     char buf[1024];
     path_build(buf, sizeof(buf), ANGBAND_DIR_USER, fname);
     spoiler_file = angband_fopen(buf, "w");
@@ -210,7 +208,7 @@ spoiler_output_status spoil_mon_info(concptr fname)
     }
 
     uint16_t why = 2;
-    ang_sort(&dummy, who, &why, n, ang_sort_comp_hook, ang_sort_swap_hook);
+    ang_sort(who, n, [why](MONRACE_IDX w1, MONRACE_IDX w2) { return ang_sort_comp_hook(w1, w2, why); });
     for (int i = 0; i < n; i++) {
         monster_race *r_ptr = &r_info[who[i]];
         BIT_FLAGS flags1 = r_ptr->flags1;
@@ -577,6 +577,17 @@ void wiz_reset_realms(player_type *creature_ptr)
     handle_stuff(creature_ptr);
 }
 
+/*!
+ * @brief メッセージ履歴の統計情報を表示する / Show the statistics of the message history
+ */
+void wiz_show_message_stats(void)
+{
+    const auto &stats = get_message_history_stats();
+    msg_format(_("メッセージ: 追加%lu 共有%lu 消去%lu", "Messages: %lu added, %lu shared, %lu evicted"), (ulong)stats.messages, (ulong)stats.deduplicated,
+        (ulong)stats.evicted);
+    msg_format(_("アリーナ書込: %luバイト ヒープ確保: %lu回", "Arena: %lu bytes written, %lu heap allocations"), (ulong)stats.arena_bytes, (ulong)stats.allocations);
+}
+
 /*!
  * @brief 現在のオプション設定をダンプ出力する /
  * @param creature_ptr プレーヤーへの参照ポインタ
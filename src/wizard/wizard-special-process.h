@@ -15,6 +15,7 @@ void wiz_reset_race(player_type *creature_ptr);
 void wiz_reset_class(player_type *creature_ptr);
 void wiz_reset_realms(player_type *creature_ptr);
 void wiz_dump_options(void);
+void wiz_show_message_stats(void);
 void set_gametime(void);
 void wiz_zap_surrounding_monsters(player_type *caster_ptr);
 void wiz_zap_floor_monsters(player_type *caster_ptr);
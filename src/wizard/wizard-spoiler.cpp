@@ -98,7 +98,6 @@ static spoiler_output_status spoil_mon_evol(concptr fname)
 {
     char buf[1024];
     monster_race *r_ptr;
-    player_type dummy;
     int **evol_tree, i, j, n, r_idx;
     int *evol_tree_zero; /* For C_KILL() */
     path_build(buf, sizeof buf, ANGBAND_DIR_USER, fname);
@@ -150,7 +149,7 @@ static spoiler_output_status spoil_mon_evol(concptr fname)
         }
     }
 
-    ang_sort(&dummy, evol_tree, NULL, max_r_idx, ang_sort_comp_evol_tree, ang_sort_swap_evol_tree);
+    ang_sort(evol_tree, max_r_idx, ang_sort_comp_evol_tree);
     for (i = 0; i < max_r_idx; i++) {
         r_idx = evol_tree[i][0];
         if (!r_idx)
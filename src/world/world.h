@@ -33,6 +33,7 @@ struct world_type {
     uint32_t seed_town{}; /* Hack -- consistent town layout */
 
     bool is_loading_now{}; /*!< ロード処理中フラグ...ロード直後にcalc_bonus()時の徳変化、及びsanity_blast()による異常を抑止する */
+    bool is_prefetching_floor{}; /*!< 次フロア先行生成中フラグ...生成中のメッセージ表示とモンスターの視認処理を抑止する */
 
     byte h_ver_major{}; //!< 変愚蛮怒バージョン(メジャー番号) / Hengband version (major ver.)
     byte h_ver_minor{}; //!< 変愚蛮怒バージョン(マイナー番号) / Hengband version (minor ver.)